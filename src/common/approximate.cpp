@@ -0,0 +1,358 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_APPROXIMATE__
+#define __FIMCP_COMMON_APPROXIMATE__
+
+#include "approximate.hh"
+#include "fimcp_blocks.hh"
+#include "tidset.hh"
+#include "phases.hh"
+#include "checkpoint.hh"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+/// Random numbers of the sample (splitmix64)
+class SampleRandom {
+  unsigned long long state;
+public:
+  SampleRandom(unsigned int seed) : state(seed) {}
+  /// Uniform in [0,1)
+  double uniform(void) {
+    unsigned long long z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    z = z ^ (z >> 31);
+    return (z >> 11) * (1.0/9007199254740992.0);
+  }
+};
+
+int Approximate::d_index(const Dataset& data) {
+    vector<int> sizes(data.nr_t, 0);
+    for (int t=0; t!=data.nr_t; t++) {
+        for (int i=0; i!=data.nr_i; i++)
+            sizes[t] += data.tdb[t][i];
+    }
+    sort(sizes.begin(), sizes.end(), greater<int>());
+    int d = 0;
+    while (d != data.nr_t && sizes[d] >= d+1)
+        d++;
+    return d;
+}
+
+vector<int> Approximate::draw(const Dataset& data, int n, bool stratified, unsigned int seed) {
+    // the stratum of every transaction: its class, or else its size
+    vector<int> stratum(data.nr_t, 0);
+    if (stratified) {
+        for (int t=0; t!=data.nr_t; t++) {
+            if (data.classes.size() != 0) {
+                stratum[t] = data.classes[t];
+            } else {
+                for (int i=0; i!=data.nr_i; i++)
+                    stratum[t] += data.tdb[t][i];
+            }
+        }
+    }
+    int nr_s = *max_element(stratum.begin(), stratum.end()) + 1;
+    vector<long> total(nr_s, 0);
+    for (int t=0; t!=data.nr_t; t++)
+        total[stratum[t]]++;
+
+    // n over the strata in proportion to their size (largest remainder)
+    vector<long> want(nr_s, 0);
+    vector< pair<double,int> > rest;
+    long given = 0;
+    for (int s=0; s!=nr_s; s++) {
+        double share = (double)n*total[s]/data.nr_t;
+        want[s] = (long)share;
+        given += want[s];
+        rest.push_back(make_pair(share - want[s], s));
+    }
+    sort(rest.begin(), rest.end(), greater< pair<double,int> >());
+    for (int k=0; given < n; k++, given++)
+        want[rest[k].second]++;
+
+    // one pass, every transaction is taken with probability
+    // (still wanted)/(still to come) in its stratum (Knuth's algorithm S)
+    SampleRandom random(seed);
+    vector<int> rows;
+    rows.reserve(n);
+    for (int t=0; t!=data.nr_t; t++) {
+        int s = stratum[t];
+        if (random.uniform()*total[s] < want[s]) {
+            rows.push_back(t);
+            want[s]--;
+        }
+        total[s]--;
+    }
+    return rows;
+}
+
+bool Approximate::read(FILE* f, vector<Candidate>& cands) {
+    char line[65536];
+    while (fgets(line, sizeof(line), f) != NULL) {
+        Candidate c;
+        char* p = line;
+        while (*p != '(' && *p != '\0') {
+            char* e;
+            long i = strtol(p, &e, 10);
+            if (e == p)
+                break;
+            c.items.push_back(i);
+            p = e;
+            while (*p == ' ')
+                p++;
+        }
+        int supp = 0;
+        c.neg = 0;
+        if (sscanf(p, "(%d:+%d-%d)", &supp, &c.pos, &c.neg) == 3) {
+            // labelled
+        } else if (sscanf(p, "(%d)", &supp) == 1) {
+            c.pos = supp;
+        } else {
+            return false;
+        }
+        sort(c.items.begin(), c.items.end());
+        cands.push_back(c);
+    }
+    return true;
+}
+
+int Approximate::run(Options_fimcp& opt, SolveFn solve) {
+    if (strcmp(opt.batch(),"") != 0 || strcmp(opt.store(),"") != 0 || opt.hybrid() ||
+        Checkpoint::enabled()) {
+        fprintf(stderr, "\tError: -approx can not be used with -batch, -store, -hybrid or -checkpoint !\n");
+        return 1;
+    }
+    PrintStyle style = Fimcp_basic::print_style(opt);
+    if (style == PRINT_CPVARS) {
+        fprintf(stderr, "\tError: -output cpvars can not be used with -approx !\n");
+        return 1;
+    }
+    if ((style == PRINT_FULL || style == PRINT_BINFULL) && !opt.approxverify()) {
+        fprintf(stderr, "\tError: -approx prints the transactions only with -approxverify 1 !\n");
+        return 1;
+    }
+    double epsilon = opt.approx();
+    double delta = opt.approxdelta();
+    if (epsilon <= 0 || epsilon >= 1 || delta <= 0 || delta >= 1) {
+        fprintf(stderr, "\tError: -approx and -approxdelta must be in (0,1) !\n");
+        return 1;
+    }
+
+    // the blocks of the model: with class labels -freq counts the positive
+    // transactions, -infreq the negative ones
+    const Fimcp_blocks model(Fimcp_blocks::spec(opt).c_str());
+    bool labels = model.labels();
+    bool infrequent = false, emerging = false, supersets = false;
+    for (int k=0; k!=model.size(); k++) {
+        string b = model.block(k);
+        infrequent |= (b == "infrequency");
+        emerging |= (b == "emerging");
+        supersets |= (b == "closed" || b == "deltaclosed" || b == "maximal");
+    }
+    if (opt.approxverify() && supersets) {
+        fprintf(stderr, "\tError: -approxverify can not recheck closed, deltaclosed or maximal in the data !\n");
+        return 1;
+    }
+
+    const Dataset& data = Dataset::get(opt.datafile());
+    int pos_tot = (labels ? data.nr_pos() : data.nr_t);
+    int neg_tot = data.nr_t - pos_tot;
+    if (labels && data.classes.size() == 0) {
+        fprintf(stderr, "\tError: no class labels found in %s !\n", opt.datafile());
+        return 1;
+    }
+    if (pos_tot == 0 || ((infrequent || emerging) && neg_tot == 0)) {
+        fprintf(stderr, "\tError: -approx needs positive and negative transactions !\n");
+        return 1;
+    }
+    // the sample error epsilon/2 is on the fraction of all transactions,
+    // on the fraction of the positive (negative) ones it is larger
+    double freq = (opt.freq() < 1 ? opt.freq() : opt.freq()/pos_tot);
+    double slack = epsilon/2 * data.nr_t/pos_tot;
+    if (freq - slack <= 0) {
+        fprintf(stderr, "\tError: -approx %g is too large for -freq %g !\n", epsilon, opt.freq());
+        return 1;
+    }
+    // the class is one more item of every transaction
+    int d = d_index(data) + (labels ? 1 : 0);
+    double n = ceil(8/(epsilon*epsilon) * (d + log(1/delta)));
+    if (n >= data.nr_t) {
+        fprintf(stdout, " approx: a sample of %.0f transactions (d-index %i) is not smaller than the data, mining it\n",
+                n, d);
+        return solve(opt);
+    }
+
+    // the sample, as a dataset of its own
+    bool stratified = (opt.approxsample() == SAMPLE_STRATIFIED);
+    vector<int> rows;
+    Dataset* sample = new Dataset();
+    {
+        Phases::Timer timer(Phases::MATRIX);
+        rows = draw(data, (int)n, stratified, opt.approxseed());
+        sample->nr_t = rows.size();
+        sample->nr_i = data.nr_i;
+        for (unsigned int k=0; k!=rows.size(); k++) {
+            sample->tdb.push_back(data.tdb[rows[k]]);
+            if (data.classes.size() != 0)
+                sample->classes.push_back(data.classes[rows[k]]);
+        }
+    }
+    static string name;
+    name = string(opt.datafile()) + "#sample";
+    Dataset::put(name.c_str(), sample);
+    fprintf(stdout, " approx: %s sample of %i of %i transactions (d-index %i, epsilon %g, delta %g), -freq %g on the sample\n",
+            (stratified ? "stratified" : "uniform"), (int)rows.size(), data.nr_t, d, epsilon, delta, freq - slack);
+
+    // mine it, the solutions go to a temporary file in the normal output
+    const char* datafile = opt.datafile();
+    float given_freq = opt.freq();
+    float given_infreq = opt.infreq();
+    int output = opt.output();
+    opt.datafile(name.c_str());
+    opt.freq(freq - slack);
+    if (infrequent) {
+        // raised by the error on the negative transactions, at most all of them
+        double infreq = (opt.infreq() < 1 ? opt.infreq() : opt.infreq()/neg_tot) +
+                        epsilon/2 * data.nr_t/neg_tot;
+        opt.infreq(infreq < 1 ? infreq : sample->nr_t - sample->nr_pos());
+    }
+    opt.output(OUT_FIMI);
+    FILE* tmp = tmpfile();
+    if (tmp == NULL) {
+        fprintf(stderr, "\tError: can not open a temporary file !\n");
+        return 1;
+    }
+    int r;
+    {
+        SolutionWriter capture(tmp);
+        Fimcp_basic::serving(&capture);
+        r = solve(opt);
+        Fimcp_basic::serving(NULL);
+    }
+    opt.datafile(datafile);
+    opt.freq(given_freq);
+    if (infrequent)
+        opt.infreq(given_infreq);
+    opt.output(output);
+    if (r != 0)
+        return r;
+    vector<Candidate> cands;
+    rewind(tmp);
+    if (!read(tmp, cands)) {
+        fprintf(stderr, "\tError: can not read the solutions of the sample !\n");
+        return 1;
+    }
+    fclose(tmp);
+
+    Phases::Timer timer(Phases::PRINT);
+    SolutionWriter* w = Fimcp_basic::solution_writer(opt);
+    w->put_header(style, labels, data.nr_i, data.nr_t);
+    vector<int> tids;
+    unsigned long sols = 0;
+    if (!opt.approxverify()) {
+        // the supports of the sample, scaled to the data
+        double scale = (double)data.nr_t/rows.size();
+        for (unsigned int k=0; k!=cands.size(); k++) {
+            Candidate& c = cands[k];
+            w->put_solution(style, c.items, labels, (int)floor(c.pos*scale+0.5),
+                            (int)floor(c.neg*scale+0.5), tids, data.nr_t);
+        }
+        sols = cands.size();
+    } else {
+        // a vertical copy of the items of the solutions, in one pass
+        int words = tidset_words(data.nr_t);
+        vector<int> used(data.nr_i, -1);
+        int nr_used = 0;
+        for (unsigned int k=0; k!=cands.size(); k++) {
+            for (unsigned int j=0; j!=cands[k].items.size(); j++) {
+                int i = cands[k].items[j];
+                if (i >= 0 && i < data.nr_i && used[i] == -1)
+                    used[i] = nr_used++;
+            }
+        }
+        vector<word_t> vertical((size_t)nr_used*words, 0);
+        vector<word_t> all(words, 0), pos(words, 0);
+        for (int t=0; t!=data.nr_t; t++) {
+            word_t bit = (word_t)1 << (t%WORD_BITS);
+            for (int i=0; i!=data.nr_i; i++) {
+                if (data.tdb[t][i] && used[i] != -1)
+                    vertical[(size_t)used[i]*words + t/WORD_BITS] |= bit;
+            }
+            all[t/WORD_BITS] |= bit;
+            if (data.classes.size() != 0 && data.classes[t])
+                pos[t/WORD_BITS] |= bit;
+        }
+
+        // the constraints on the supports, as the blocks post them
+        unsigned int minsup = opt.getFreq(pos_tot);
+        unsigned int maxneg = (infrequent ? opt.getInfreq(neg_tot) : 0);
+        float deltaPosNeg = (emerging ? PRECISION*opt.delta()*pos_tot/(float)neg_tot : 0);
+        vector<word_t> set(words);
+        for (unsigned int k=0; k!=cands.size(); k++) {
+            Candidate& c = cands[k];
+            set = all;
+            int supp = data.nr_t;
+            for (unsigned int j=0; j!=c.items.size(); j++) {
+                int i = c.items[j];
+                if (i < 0 || i >= data.nr_i) {
+                    supp = 0;
+                    break;
+                }
+                supp = tidset_and(set.data(), set.data(), &vertical[(size_t)used[i]*words], words);
+            }
+            c.pos = (labels ? tidset_and_count(set.data(), pos.data(), words) : supp);
+            c.neg = supp - c.pos;
+            if (c.pos < (int)minsup)
+                continue;
+            if (infrequent && c.neg > (int)maxneg)
+                continue;
+            if (emerging && c.items.size() != 0 &&
+                c.pos*PRECISION + c.neg*(int)(-deltaPosNeg) <= 0)
+                continue;
+            tids.clear();
+            if (style == PRINT_FULL || style == PRINT_BINFULL)
+                tidset_list(set.data(), words, tids);
+            w->put_solution(style, c.items, labels, c.pos, c.neg, tids, data.nr_t);
+            sols++;
+        }
+    }
+    fprintf(stdout, " approx: %lu solutions on the sample, %lu %s\n", (unsigned long)cands.size(), sols,
+            (opt.approxverify() ? "rechecked in the data" : "printed with estimated supports"));
+    return 0;
+}
+
+#endif
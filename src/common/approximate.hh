@@ -0,0 +1,93 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_APPROXIMATE_HH__
+#define __FIMCP_COMMON_APPROXIMATE_HH__
+
+#include <vector>
+using namespace std;
+
+#include "fimcp_basic.hh"
+#include "dataset.hh"
+
+/**
+ * \brief Approximate mining on a sample of the transactions (-approx)
+ *
+ * With -approx <epsilon> a model does not mine the dataset but a sample
+ * of its transactions, large enough that with probability 1 - -approxdelta
+ * the frequency of every itemset in the sample is within epsilon/2 of its
+ * frequency in the data (Riondato and Upfal, via the d-index of the data:
+ * the largest d such that d transactions have at least d items):
+ *   n = 8/epsilon^2 * (d + ln(1/delta))
+ * The model mines the sample with -freq lowered by epsilon/2, so it
+ * finds every itemset that is frequent in the data, and every itemset it
+ * finds has a frequency of at least -freq minus epsilon in the data. If
+ * the sample would not be smaller than the data, the data is mined.
+ *
+ * -approxsample uniform draws the transactions uniformly without
+ * replacement, stratified draws the same fraction of every class (or of
+ * every transaction size without labels). The supports printed are
+ * those of the sample scaled to the data. With -approxverify 1 the
+ * solutions are counted in the data instead, in one pass over a vertical
+ * copy of the items they use, and those that break a constraint on their
+ * supports (frequency, infrequency, emerging) are dropped. Closed,
+ * deltaclosed and maximal compare an itemset with its supersets, they
+ * can not be rechecked this way: -approxverify refuses those models.
+ *
+ * With class labels -freq is a fraction of the positive transactions
+ * (-infreq of the negative ones), the thresholds of the sample are moved
+ * by epsilon/2 scaled to that fraction.
+ */
+class Approximate {
+public:
+  /// Mining function of a model (see Server)
+  typedef int (*SolveFn)(Options_fimcp&);
+  /// Mine a sample of the data of \a opt with \a solve, print the solutions
+  static int run(Options_fimcp& opt, SolveFn solve);
+
+protected:
+  /// A solution found on the sample
+  struct Candidate {
+    vector<int> items;
+    int pos;
+    int neg;
+  };
+  /// The largest d such that \a data has d transactions of at least d items
+  static int d_index(const Dataset& data);
+  /// Transactions of a sample of \a n of \a data, in the order of the data
+  static vector<int> draw(const Dataset& data, int n, bool stratified, unsigned int seed);
+  /// Read the solutions written in the normal output to \a f
+  static bool read(FILE* f, vector<Candidate>& cands);
+};
+
+#endif
@@ -0,0 +1,184 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_BATCH__
+#define __FIMCP_COMMON_BATCH__
+
+#include "batch.hh"
+#include "phases.hh"
+
+/// The options a setting may change, all others are shared by the base
+static const char* batch_keys[] = {
+    "freq", "infreq", "delta", "epsilon", "alpha", "beta", "bound1", "bound2"
+};
+
+/// \a s without leading and trailing spaces
+static string trim(const string& s) {
+    size_t b = s.find_first_not_of(" \t");
+    if (b == string::npos)
+        return "";
+    size_t e = s.find_last_not_of(" \t");
+    return s.substr(b, e-b+1);
+}
+
+/// Pieces of \a s between the separators \a sep (empty ones skipped)
+static vector<string> split(const string& s, const char* sep) {
+    vector<string> out;
+    size_t k = 0;
+    while (k <= s.size()) {
+        size_t e = s.find_first_of(sep, k);
+        if (e == string::npos)
+            e = s.size();
+        string piece = trim(s.substr(k, e-k));
+        if (piece != "")
+            out.push_back(piece);
+        k = e+1;
+    }
+    return out;
+}
+
+/// The settings in \a s, exits on a malformed one
+vector<Batch::Setting> Batch::parse(const char* s) {
+    vector<Setting> settings;
+    if (strchr(s, '=') == NULL) {
+        // plain list of minimal frequencies
+        vector<string> freqs = split(s, " ,;");
+        for (unsigned int k=0; k!=freqs.size(); k++)
+            settings.push_back(Setting(1, make_pair(string("-freq"), freqs[k])));
+        return settings;
+    }
+
+    vector<string> tuples = split(s, ";");
+    for (unsigned int k=0; k!=tuples.size(); k++) {
+        Setting setting;
+        vector<string> pairs = split(tuples[k], ",");
+        for (unsigned int p=0; p!=pairs.size(); p++) {
+            size_t eq = pairs[p].find('=');
+            string key = (eq == string::npos ? pairs[p] : trim(pairs[p].substr(0, eq)));
+            bool known = false;
+            for (unsigned int j=0; j!=sizeof(batch_keys)/sizeof(batch_keys[0]); j++)
+                known |= (key == batch_keys[j]);
+            if (eq == string::npos || !known) {
+                fprintf(stderr, "\tError: setting '%s' of -batch is not key=value with key one of freq, infreq, delta, epsilon, alpha, beta, bound1, bound2 !\n",
+                        pairs[p].c_str());
+                exit(1);
+            }
+            setting.push_back(make_pair("-"+key, trim(pairs[p].substr(eq+1))));
+        }
+        settings.push_back(setting);
+    }
+    return settings;
+}
+
+/// Mine all settings of -batch in \a opt
+void Batch::run(Options_fimcp& opt) {
+    Phases::Timer timer(Phases::SEARCH);
+    fprintf(stdout, "%s\n", opt.name());
+    const vector<Setting> settings = parse(opt.batch());
+    if (settings.size() == 0) {
+        fprintf(stderr, "\tError: no settings in -batch !\n");
+        exit(1);
+    }
+    PrintStyle style = Fimcp_basic::print_style(opt);
+    if (style == PRINT_CPVARS) {
+        fprintf(stderr, "\tError: -output cpvars can not be used with -batch !\n");
+        exit(1);
+    }
+    if (strcmp(opt.shape(),"") != 0 || strcmp(opt.trace(),"") != 0 || strcmp(opt.checkpoint(),"") != 0) {
+        fprintf(stderr, "\tError: -shape, -trace and -checkpoint can not be used with -batch !\n");
+        exit(1);
+    }
+
+    // the base, shared by all settings
+    Support::Timer t;
+    t.start();
+    Fimcp_basic* base = new Fimcp_basic(opt, PHASE_BASE);
+    if (base->status() == SS_FAILED) {
+        // coverage and closedness alone always have the empty itemset
+        fprintf(stderr, "\tError: the base of the batch has no solutions !\n");
+        exit(1);
+    }
+    fprintf(stdout, " batch: %lu settings, base posted in %.3f ms\n",
+            (unsigned long)settings.size(), t.stop());
+
+    string prefix = (strcmp(opt.solfile(),"") != 0 ? opt.solfile() : opt.name());
+    Search::Options so;
+    so.threads = opt.threads();
+    so.c_d = opt.c_d();
+    so.a_d = opt.a_d();
+    // a setting changes the command line values, not those of the one before
+    const Options_fimcp::Thresholds given = opt.thresholds();
+    for (unsigned int k=0; k!=settings.size(); k++) {
+        opt.thresholds(given);
+        string desc;
+        for (unsigned int p=0; p!=settings[k].size(); p++) {
+            if (!opt.set(settings[k][p].first.c_str(), settings[k][p].second)) {
+                fprintf(stderr, "\tError: %s is not an option of %s !\n",
+                        settings[k][p].first.c_str(), opt.name());
+                exit(1);
+            }
+            desc += (p == 0 ? "" : " ") + settings[k][p].first + " " + settings[k][p].second;
+        }
+
+        char file[1024];
+        snprintf(file, sizeof(file), "%s.%u", prefix.c_str(), k+1);
+        FILE* f = fopen(file, (style == PRINT_BINARY || style == PRINT_BINFULL) ? "wb" : "w");
+        if (f == NULL) {
+            fprintf(stderr, "\tError: can not open %s !\n", file);
+            exit(1);
+        }
+        SolutionWriter* w = new SolutionWriter(f, false, 1<<20, opt.outring());
+
+        t.start();
+        Fimcp_basic* s = static_cast<Fimcp_basic*>(base->clone());
+        s->setting(opt, w);
+        DFS<Fimcp_basic> e(s, so);
+        delete s;
+        unsigned long sols = 0;
+        while (Fimcp_basic* sol = e.next()) {
+            sol->print(std::cout);
+            delete sol;
+            if (++sols == opt.solutions() && opt.solutions() != 0)
+                break;
+        }
+        Search::Statistics stat = e.statistics();
+        delete w;
+        fclose(f);
+        fprintf(stdout, " setting %u (%s): %lu solutions in %.3f ms, %lu nodes, %lu failures -> %s\n",
+                k+1, desc.c_str(), sols, t.stop(), stat.node, stat.fail, file);
+    }
+    opt.thresholds(given);
+    delete base;
+}
+
+#endif
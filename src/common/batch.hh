@@ -0,0 +1,68 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_BATCH_HH__
+#define __FIMCP_COMMON_BATCH_HH__
+
+#include "fimcp_basic.hh"
+
+/**
+ * \brief Mines one model under many threshold settings in one run
+ *
+ * The dataset is read and the constraints that do not depend on the
+ * thresholds (coverage, closedness) are posted and propagated once, in
+ * a base space (PHASE_BASE). Every setting clones the base, posts its
+ * thresholds and the search on the clone (PHASE_SETTING) and writes its
+ * solutions to a file of its own: <solfile>.<k>, or <model>.<k> when no
+ * -solfile is given.
+ *
+ * The settings of -batch are separated by ';', every setting is a ','
+ * separated list of key=value, eg "freq=0.1,delta=0.05;freq=0.2,delta=0.1"
+ * or "freq=0.1,bound1=GQ 5". A list of plain numbers, eg "0.1 0.05 0.02",
+ * are minimal frequencies. A key that a setting does not give has its
+ * command line value, whatever the settings before it gave.
+ *
+ */
+class Batch {
+public:
+  /// A setting: pairs of option (eg "-freq") and value
+  typedef vector< pair<string,string> > Setting;
+
+  /// The settings in \a s, exits on a malformed one
+  static vector<Setting> parse(const char* s);
+
+  /// Mine all settings of -batch in \a opt
+  static void run(Options_fimcp& opt);
+};
+
+#endif
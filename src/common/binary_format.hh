@@ -0,0 +1,74 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_BINARYFORMAT_HH__
+#define __FIMCP_COMMON_BINARYFORMAT_HH__
+
+/**
+ * Binary solution format (-output binary and -output binaryfull)
+ *
+ * All numbers are unsigned varints: 7 bits per byte, least significant
+ * first, high bit set on all but the last byte.
+ *
+ * Header:
+ *   "FIMCPB" version(1 byte) flags(1 byte) nr_items nr_transactions
+ *   flags: BIN_LABELS if supports are split in pos/neg,
+ *          BIN_TIDS if every solution has its transaction set
+ *
+ * Every solution:
+ *   n, followed by the n item ids in increasing order, as gaps:
+ *     the first id, then (id - previous id - 1) for every next one
+ *   support, or pos neg if BIN_LABELS
+ *   if BIN_TIDS, the transaction set, in one of two encodings:
+ *     BIN_TIDS_RANGES(1 byte) r, then r ranges of consecutive tids,
+ *       each as (start - end of previous range) (length - 1)
+ *     BIN_TIDS_BITMAP(1 byte) ceil(nr_transactions/8) bytes,
+ *       tid t is bit (t%8) of byte (t/8)
+ *   whichever is smaller.
+ *
+ * tools/fimcp_decode converts it back to the normal/full text output.
+ */
+#define BIN_MAGIC "FIMCPB"
+#define BIN_VERSION 1
+
+enum BinFlags {
+    BIN_LABELS = 1,
+    BIN_TIDS = 2
+};
+
+enum BinTids {
+    BIN_TIDS_RANGES = 0,
+    BIN_TIDS_BITMAP = 1
+};
+
+#endif
@@ -0,0 +1,119 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_BLOCK_PROFILE__
+#define __FIMCP_COMMON_BLOCK_PROFILE__
+
+#include "block_profile.hh"
+
+Block_profile::Block_profile(const vector<string>& n, unsigned long m) :
+    names(n), blocks(n.size()), nodes(0), fails(0), sols(0), max_sols(m) {}
+
+void Block_profile::node(vector<Fimcp_basic*>& stages) {
+    nodes++;
+    // every stage to its fixpoint, compared to the stage before
+    int n = stages.size();
+    unsigned long prev_prop = 0;
+    int prev_pruned = 0;
+    double prev_ms = 0;
+    bool failed = false;
+    for (int k=0; k!=n; k++) {
+        int before = stages[k]->assigned();
+        StatusStatistics stat;
+        Support::Timer t;
+        t.start();
+        failed = (stages[k]->status(stat) == SS_FAILED);
+        double ms = t.stop();
+        int pruned = (failed ? 0 : stages[k]->assigned() - before);
+
+        Counters& c = blocks[k];
+        if (stat.propagate > prev_prop) {
+            c.propagations += stat.propagate - prev_prop;
+            c.fixpoints++;
+        }
+        if (pruned > prev_pruned)
+            c.pruned += pruned - prev_pruned;
+        if (ms > prev_ms)
+            c.ms += ms - prev_ms;
+        prev_prop = stat.propagate;
+        prev_pruned = pruned;
+        prev_ms = ms;
+        if (failed)
+            break; // so do all later stages
+    }
+
+    int item = (failed ? -1 : stages[n-1]->unassigned_item());
+    if (failed) {
+        fails++;
+    } else if (item == -1) {
+        sols++;
+    } else {
+        // branch: item = 1, then item = 0
+        for (int v=1; v>=0 && (max_sols == 0 || sols < max_sols); v--) {
+            vector<Fimcp_basic*> child(n);
+            for (int k=0; k!=n; k++) {
+                child[k] = static_cast<Fimcp_basic*>(stages[k]->clone());
+                child[k]->assign_item(item, v);
+            }
+            node(child);
+        }
+    }
+    for (int k=0; k!=n; k++)
+        delete stages[k];
+}
+
+void Block_profile::print(void) const {
+    fprintf(stdout, " profile: %lu nodes, %lu failures, %lu solutions (cost of every block on top of the blocks before it)\n",
+            nodes, fails, sols);
+    for (unsigned int k=0; k!=blocks.size(); k++) {
+        const Counters& c = blocks[k];
+        fprintf(stdout, "\t%-14s %8u propagators %12lu propagations in %8lu fixpoints %10lu pruned %10.3f ms\n",
+                names[k].c_str(), c.propagators, c.propagations, c.fixpoints, c.pruned, c.ms);
+    }
+}
+
+void Block_profile::run(const Options_fimcp& opt, const vector<string>& names, Stage stage) {
+    fprintf(stdout, "%s\n", opt.name());
+    Block_profile p(names, opt.solutions());
+    vector<Fimcp_basic*> stages(names.size());
+    unsigned int prev = 0;
+    for (unsigned int k=0; k!=names.size(); k++) {
+        stages[k] = stage(opt, k+1);
+        p.blocks[k].propagators = stages[k]->propagators() - prev;
+        prev = stages[k]->propagators();
+    }
+    p.node(stages);
+    p.print();
+}
+
+#endif
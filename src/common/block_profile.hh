@@ -0,0 +1,99 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_BLOCK_PROFILE_HH__
+#define __FIMCP_COMMON_BLOCK_PROFILE_HH__
+
+#include <string>
+#include <vector>
+using namespace std;
+
+#include "fimcp_basic.hh"
+
+/**
+ * \brief Propagation profile of the constraint blocks of a model (-profile)
+ *
+ * Gecode does not say which propagator did what, so the model is built
+ * in stages: stage k has the blocks 0..k (coverage first, see
+ * Fimcp_blocks). All stages are searched together, in the same tree:
+ * the search branches on the first unassigned item, 1 before 0, and
+ * stops at the failures of the complete model. At every node every
+ * stage propagates to its fixpoint, and block k is charged what stage
+ * k costs more than stage k-1:
+ *  - propagators: propagators posted by the block
+ *  - propagations: propagator executions (Gecode's StatusStatistics)
+ *  - fixpoints: nodes where the block caused extra propagations
+ *  - pruned: variables (items and transactions) it assigned
+ *  - time: propagation time
+ *
+ * This is the incremental cost of adding the block to the blocks before
+ * it, which is what a dedicated propagator for the block would save.
+ * The tree is that of input order branching, which can be larger than
+ * the tree of the model's own branching.
+ *
+ */
+class Block_profile {
+public:
+  /// Builds the stage with the first \a blocks blocks of the model of \a opt
+  typedef Fimcp_basic* (*Stage)(const Options_fimcp& opt, int blocks);
+
+protected:
+  /// what block k costs more than block k-1
+  struct Counters {
+    unsigned int propagators;
+    unsigned long propagations;
+    unsigned long fixpoints;
+    unsigned long pruned;
+    double ms;
+    Counters(void) : propagators(0), propagations(0), fixpoints(0), pruned(0), ms(0) {}
+  };
+  vector<string> names;
+  vector<Counters> blocks;
+  unsigned long nodes;
+  unsigned long fails;
+  unsigned long sols;
+  /// stop after this many solutions (0: all)
+  unsigned long max_sols;
+
+  Block_profile(const vector<string>& names, unsigned long max_sols);
+  /// Propagate the \a stages of a node and search below it (takes ownership)
+  void node(vector<Fimcp_basic*>& stages);
+  /// Print the counters
+  void print(void) const;
+
+public:
+  /// Profile the blocks \a names of the model of \a opt, built by \a stage
+  static void run(const Options_fimcp& opt, const vector<string>& names, Stage stage);
+};
+
+#endif
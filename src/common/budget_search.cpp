@@ -0,0 +1,165 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_BUDGET_SEARCH__
+#define __FIMCP_COMMON_BUDGET_SEARCH__
+
+#include "budget_search.hh"
+#include "phases.hh"
+#include "checkpoint.hh"
+
+#include <iostream>
+#include <cmath>
+
+Budget_search::Budget_search(const Options_fimcp& opt, double b, double c) :
+    budget(b), copy_size(c), copies(0), max_sols(opt.solutions()),
+    nodes(0), fails(0), sols(Checkpoint::solutions()), propagations(0), recomputations(0),
+    copies_max(0), depth_max(0), writer(Fimcp_basic::solution_writer(opt)), checkpoint_seen(0) {}
+
+void Budget_search::node(Fimcp_basic* s, const Fimcp_basic* anchor, vector<Edge>& path, int depth, bool resumed) {
+    // above the node of a resumed checkpoint the state is not that of a
+    // checkpoint: the nodes left of the path are done
+    const vector<int>& resume = Checkpoint::path();
+    resumed = resumed && depth != (int)resume.size();
+    if (!resumed && Checkpoint::enabled() && Checkpoint::due(checkpoint_seen))
+        Checkpoint::save(alts, sols, writer);
+
+    nodes++;
+    if (depth > depth_max)
+        depth_max = depth;
+    StatusStatistics stat;
+    SpaceStatus status = s->status(stat);
+    propagations += stat.propagate;
+    if (status == SS_FAILED) {
+        fails++;
+        return;
+    }
+    if (status == SS_SOLVED) {
+        sols++;
+        s->print(std::cout);
+        return;
+    }
+
+    const Choice* c = s->choice();
+    unsigned int n = c->alternatives();
+    // a resumed checkpoint continues at its alternative
+    unsigned int first = (resumed ? resume[depth] : 0);
+    if (first >= n) {
+        fprintf(stderr, "\tError: the checkpoint does not match the search of this dataset !\n");
+        exit(1);
+    }
+    alts.push_back(0);
+    if (copying()) {
+        // s stays as it is: the children are clones of it, their
+        // recomputations start from it
+        copies++;
+        if (copies > copies_max)
+            copies_max = copies;
+        for (unsigned int a=first; a+1!=n && !stopped(); a++) {
+            Fimcp_basic* child = static_cast<Fimcp_basic*>(s->clone());
+            child->commit(*c, a);
+            vector<Edge> from_s(1, Edge(c, a));
+            alts.back() = a;
+            node(child, s, from_s, depth+1, resumed && a == first);
+            delete child;
+        }
+        copies--;
+        // the last child takes over s, recomputed from the anchor of s
+        if (!stopped()) {
+            s->commit(*c, n-1);
+            path.push_back(Edge(c, n-1));
+            alts.back() = n-1;
+            node(s, anchor, path, depth+1, resumed && n-1 == first);
+            path.pop_back();
+        }
+    } else {
+        // the first child takes over s, the others are recomputed
+        for (unsigned int a=first; a!=n && !stopped(); a++) {
+            Fimcp_basic* child = s;
+            if (a != first) {
+                child = static_cast<Fimcp_basic*>(anchor->clone());
+                for (unsigned int k=0; k!=path.size(); k++)
+                    child->commit(*path[k].choice, path[k].alt);
+                recomputations += path.size();
+            }
+            child->commit(*c, a);
+            path.push_back(Edge(c, a));
+            alts.back() = a;
+            node(child, anchor, path, depth+1, resumed && a == first);
+            path.pop_back();
+            if (child != s)
+                delete child;
+        }
+    }
+    alts.pop_back();
+    delete c;
+}
+
+void Budget_search::run(const Options_fimcp& opt) {
+    if (opt.threads() != 1) {
+        fprintf(stderr, "\tError: -membudget searches with one thread, -threads can not be used !\n");
+        exit(1);
+    }
+    Support::Timer t;
+    t.start();
+    fprintf(stdout, "%s\n", opt.name());
+    Fimcp_basic* root = new Fimcp_basic(opt);
+    root->status();
+    // what is left of the budget once the data is read and posted
+    double budget = HUGE_VAL;
+    if (opt.membudget() != 0)
+        budget = opt.membudget()*1048576.0 - Phases::rss()*1024.0;
+    if (budget <= 0)
+        fprintf(stdout, " Warning: -membudget %u MB is used before the search, every node is recomputed.\n",
+                opt.membudget());
+    Budget_search search(opt, budget, (double)root->allocated());
+
+    // the root keeps a copy: the recomputations below its last child start there
+    const Fimcp_basic* anchor = static_cast<Fimcp_basic*>(root->clone());
+    vector<Edge> path;
+    search.node(root, anchor, path, 0, Checkpoint::resuming());
+    delete root;
+    delete anchor;
+
+    fprintf(stdout, "\nSummary\n");
+    fprintf(stdout, "\truntime:      %.3f ms\n", t.stop());
+    fprintf(stdout, "\tsolutions:    %lu\n", search.sols);
+    fprintf(stdout, "\tpropagations: %lu\n", search.propagations);
+    fprintf(stdout, "\tnodes:        %lu\n", search.nodes);
+    fprintf(stdout, "\tfailures:     %lu\n", search.fails);
+    fprintf(stdout, "\tpeak depth:   %i\n", search.depth_max);
+    fprintf(stdout, "\tpeak copies:  %lu of %.0f KB\n", search.copies_max, search.copy_size/1024);
+    fprintf(stdout, "\trecomputed:   %lu commits\n", search.recomputations);
+}
+
+#endif
@@ -0,0 +1,108 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_BUDGET_SEARCH_HH__
+#define __FIMCP_COMMON_BUDGET_SEARCH_HH__
+
+#include <vector>
+using namespace std;
+
+#include "fimcp_basic.hh"
+
+/**
+ * \brief Depth-first search within a memory budget (-membudget) and
+ * with checkpoints (-checkpoint)
+ *
+ * With -c-d 0 Gecode keeps a copy of the space at every open node: fast,
+ * but a deep search with many transactions runs out of memory. This
+ * search decides at every node instead:
+ *  - copying: while the copies it keeps fit in 3/4 of the budget, the
+ *    node keeps its space and its children are clones of it
+ *  - recomputation: otherwise the first child takes over the space of
+ *    the node, the other children are recomputed from the nearest
+ *    ancestor that kept its space, by committing the alternatives on
+ *    the path from it again
+ * So the commit distance grows where memory is short and shrinks again
+ * when the copies are freed; a run gets slower instead of being killed.
+ *
+ * The memory of a copy is that of the root (Space::allocated), the
+ * budget is what is left of -membudget after reading and posting. The
+ * native Eclat engine spills its tidsets to diffsets near the budget
+ * instead (see Fimcp_eclat::dense).
+ *
+ * The path of alternatives from the root is what a checkpoint records
+ * (see Checkpoint). Resuming one, the nodes on its path are recomputed
+ * and only their alternatives from that of the path on are searched;
+ * without -membudget every node keeps a copy, as with -c-d 0.
+ */
+class Budget_search {
+protected:
+  /// an alternative on the path from the nearest copy
+  struct Edge {
+    const Choice* choice;
+    unsigned int alt;
+    Edge(const Choice* c, unsigned int a) : choice(c), alt(a) {}
+  };
+  /// bytes the copies may use, bytes of a copy
+  double budget;
+  double copy_size;
+  /// copies alive
+  unsigned long copies;
+  /// stop after this many solutions (0: all)
+  unsigned long max_sols;
+  /// statistics
+  unsigned long nodes, fails, sols, propagations, recomputations, copies_max;
+  int depth_max;
+  /// the alternative taken at every depth, for the checkpoints
+  vector<int> alts;
+  SolutionWriter* writer;
+  unsigned int checkpoint_seen;
+
+  Budget_search(const Options_fimcp& opt, double budget, double copy_size);
+  /// Search below \a s at \a depth, \a path leads from \a anchor to \a s,
+  /// \a resumed: \a s is on the path of the resumed checkpoint
+  void node(Fimcp_basic* s, const Fimcp_basic* anchor, vector<Edge>& path, int depth, bool resumed);
+  /// May the node keep its space?
+  bool copying(void) const {
+    return (copies+1)*copy_size < 0.75*budget;
+  }
+  bool stopped(void) const {
+    return max_sols != 0 && sols >= max_sols;
+  }
+
+public:
+  /// Search the model of \a opt, print its solutions and statistics
+  static void run(const Options_fimcp& opt);
+};
+
+#endif
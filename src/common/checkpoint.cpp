@@ -0,0 +1,144 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_CHECKPOINT__
+#define __FIMCP_COMMON_CHECKPOINT__
+
+#include "checkpoint.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <chrono>
+
+bool Checkpoint::on = false;
+string Checkpoint::file;
+string Checkpoint::command;
+unsigned int Checkpoint::interval = 0;
+atomic<unsigned int> Checkpoint::tick(0);
+vector<int> Checkpoint::resume_path;
+unsigned long Checkpoint::resume_sols = 0;
+long Checkpoint::resume_offset = 0;
+vector<int> Checkpoint::resume_stack;
+
+void Checkpoint::enable(const char* f, unsigned int seconds, const string& c) {
+    if (on)
+        return;
+    on = true;
+    file = f;
+    command = c;
+    interval = (seconds == 0 ? 1 : seconds);
+    read();
+    thread(timer).detach();
+}
+
+/// Read a vector written as its size followed by the elements
+static bool read_ints(FILE* f, const char* key, vector<int>& v) {
+    char k[32];
+    unsigned int n;
+    if (fscanf(f, "%31s %u", k, &n) != 2 || strcmp(k, key) != 0)
+        return false;
+    v.resize(n);
+    for (unsigned int i=0; i!=n; i++) {
+        if (fscanf(f, "%i", &v[i]) != 1)
+            return false;
+    }
+    return true;
+}
+
+void Checkpoint::read(void) {
+    FILE* f = fopen(file.c_str(), "r");
+    if (f == NULL)
+        return; // a new run
+    char line[4096];
+    bool ok = (fgets(line, sizeof(line), f) != NULL && strcmp(line, "fimcp checkpoint 1\n") == 0);
+    if (ok && (fgets(line, sizeof(line), f) == NULL || strncmp(line, "run ", 4) != 0 ||
+               string(line+4) != command + "\n")) {
+        fprintf(stderr, "\tError: checkpoint %s is of another run (%s), remove it to start again !\n",
+                file.c_str(), line);
+        exit(1);
+    }
+    ok = ok && fscanf(f, " solutions %lu offset %ld", &resume_sols, &resume_offset) == 2 &&
+        read_ints(f, "path", resume_path) && read_ints(f, "stack", resume_stack);
+    fclose(f);
+    if (!ok) {
+        fprintf(stderr, "\tError: can not read checkpoint %s !\n", file.c_str());
+        exit(1);
+    }
+    fprintf(stdout, " resuming checkpoint %s: %lu solutions, depth %lu\n",
+            file.c_str(), resume_sols, (unsigned long)resume_path.size());
+}
+
+void Checkpoint::resume(SolutionWriter* w) {
+    w->resume(resume_offset, resume_stack);
+}
+
+void Checkpoint::save(const vector<int>& p, unsigned long sols, SolutionWriter* w) {
+    long offset = w->sync();
+    const vector<int>& stack = w->delta_stack();
+    string tmp = file + ".tmp";
+    FILE* f = fopen(tmp.c_str(), "w");
+    if (f == NULL) {
+        fprintf(stderr, "\tError: can not open %s !\n", tmp.c_str());
+        exit(1);
+    }
+    fprintf(f, "fimcp checkpoint 1\nrun %s\nsolutions %lu\noffset %ld\npath %lu",
+            command.c_str(), sols, offset, (unsigned long)p.size());
+    for (unsigned int k=0; k!=p.size(); k++)
+        fprintf(f, " %i", p[k]);
+    fprintf(f, "\nstack %lu", (unsigned long)stack.size());
+    for (unsigned int k=0; k!=stack.size(); k++)
+        fprintf(f, " %i", stack[k]);
+    fprintf(f, "\n");
+    if (fclose(f) != 0 || rename(tmp.c_str(), file.c_str()) != 0) {
+        fprintf(stderr, "\tError: can not write checkpoint %s !\n", file.c_str());
+        exit(1);
+    }
+}
+
+void Checkpoint::finish(void) {
+    if (on) {
+        on = false;
+        remove(file.c_str());
+    }
+}
+
+void Checkpoint::timer(void) {
+    while (true) {
+        this_thread::sleep_for(chrono::seconds(interval));
+        tick.fetch_add(1, memory_order_relaxed);
+    }
+}
+
+#endif
@@ -0,0 +1,119 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_CHECKPOINT_HH__
+#define __FIMCP_COMMON_CHECKPOINT_HH__
+
+#include <atomic>
+#include <string>
+#include <vector>
+using namespace std;
+
+#include "solution_writer.hh"
+
+/**
+ * \brief Checkpoints of a long search, to resume it (-checkpoint)
+ *
+ * With -checkpoint <file> the search writes to <file> every
+ * -checkpointevery seconds where it is: the path from the root to the
+ * node it is about to search, as the alternative taken at every depth
+ * (the CP engine: the value tried for an item, in the order of
+ * -branchval; Eclat: the candidate item extending the prefix), and what
+ * it wrote before that node: the nr of solutions and the size of the
+ * -solfile. Every node left of the path is done, every node right of it
+ * is still open. The file is replaced atomically (write and rename), eg
+ *   fimcp checkpoint 1
+ *   run ./fimcp_closed -datafile big.txt -freq 0.01 -solfile closed.out -checkpoint closed.ckpt
+ *   solutions 81234567
+ *   offset 2011456789
+ *   path 5 0 0 1 0 1
+ *   stack 0
+ *
+ * Run the same command again after the process was killed: it finds the
+ * checkpoint, cuts the -solfile back to the offset (dropping what was
+ * written after the checkpoint), recomputes the nodes on the path from
+ * the dataset and continues right of it, so every solution is written
+ * exactly once. The checkpoint is removed when the search is complete.
+ *
+ * Like Progress, a timer thread only bumps a tick; the search compares it
+ * at every node, a checkpoint costs one flush of the -solfile.
+ */
+class Checkpoint {
+public:
+  /// Checkpoint the run \a command to \a file every \a seconds, resume
+  /// it if \a file has a checkpoint
+  static void enable(const char* file, unsigned int seconds, const string& command);
+  /// Checkpointing?
+  static bool enabled(void) { return on; }
+  /// Did the timer tick since \a seen (updated)?
+  static bool due(unsigned int& seen) {
+    unsigned int t = tick.load(memory_order_relaxed);
+    if (t == seen)
+      return false;
+    seen = t;
+    return true;
+  }
+  /// Write a checkpoint: the search is about to search the node at
+  /// \a path, it reported \a sols solutions to \a w before
+  static void save(const vector<int>& path, unsigned long sols, SolutionWriter* w);
+  /// The search is complete: remove the checkpoint
+  static void finish(void);
+
+  /// Resuming a checkpoint?
+  static bool resuming(void) { return resume_path.size() != 0; }
+  /// The path of the checkpoint that is resumed (empty: none)
+  static const vector<int>& path(void) { return resume_path; }
+  /// Solutions before the checkpoint
+  static unsigned long solutions(void) { return resume_sols; }
+  /// Continue \a w after the solutions before the checkpoint
+  static void resume(SolutionWriter* w);
+
+protected:
+  static bool on;
+  static string file;
+  static string command;
+  static unsigned int interval;
+  static atomic<unsigned int> tick;
+  /// of the checkpoint that is resumed
+  static vector<int> resume_path;
+  static unsigned long resume_sols;
+  static long resume_offset;
+  static vector<int> resume_stack;
+
+  /// Read the checkpoint in the file, if any
+  static void read(void);
+  /// The timer thread
+  static void timer(void);
+};
+
+#endif
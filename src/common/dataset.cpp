@@ -0,0 +1,151 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_DATASET__
+#define __FIMCP_COMMON_DATASET__
+
+#include "dataset.hh"
+#include "reader_eliz.cpp"
+#include "phases.hh"
+
+#include <mutex>
+
+map<string, Dataset*> Dataset::loaded;
+/// guards loaded, requests of a Server read datasets concurrently
+static std::mutex loading;
+
+Dataset::Dataset(void) : nr_t(0), nr_i(0) {}
+
+Dataset::Dataset(const char* filename, string* error) {
+    Phases::Timer timer(Phases::READ);
+    Reader_Eliz<bool> data;
+    if (error != NULL)
+        data.tolerate_errors();
+    data.read(filename);
+    if (error != NULL)
+        *error = data.error;
+    tdb.swap(data.data);
+    classes.swap(data.classes);
+    nr_t = tdb.size();
+    nr_i = (nr_t == 0 ? 0 : tdb[0].size());
+}
+
+Dataset::Dataset(int nr_items, const vector< vector<int> >& transactions,
+                 const vector<bool>& labels) :
+    nr_t(transactions.size()), nr_i(nr_items),
+    tdb(transactions.size(), vector<bool>(nr_items, false)),
+    classes(labels) {
+    for (int t=0; t!=nr_t; t++) {
+        for (unsigned int k=0; k!=transactions[t].size(); k++)
+            tdb[t][transactions[t][k]] = true;
+    }
+}
+
+float Dataset::sparseness(void) const {
+    int sum = 0;
+    for (int t=0; t!=nr_t; t++) {
+        for (int i=0; i!=nr_i; i++)
+            sum += tdb[t][i];
+    }
+    return ((float)sum/(nr_i*nr_t));
+}
+
+int Dataset::nr_pos(void) const {
+    int posTot = 0;
+    for (unsigned int t=0; t!=classes.size(); t++)
+        posTot += classes[t];
+    return posTot;
+}
+
+void Dataset::print_info(const char* name, unsigned int freq) const {
+    fprintf(stdout, " dataset %s: %ix%i:%1.2f", name, nr_t, nr_i, sparseness());
+    if (classes.size() != 0) {
+        int posTot = nr_pos();
+        fprintf(stdout, " %i:+%i-%i", nr_t, posTot, (nr_t-posTot));
+    }
+    if (freq != 0)
+        fprintf(stdout, " minfreq %i\n", freq);
+    else
+        fprintf(stdout, "\n");
+}
+
+unsigned long long Dataset::fingerprint(void) const {
+    unsigned long long h = 14695981039346656037ULL;
+    const unsigned long long prime = 1099511628211ULL;
+    h = (h ^ nr_t) * prime;
+    h = (h ^ nr_i) * prime;
+    for (int t=0; t!=nr_t; t++) {
+        // the items of every row, and its label
+        for (int i=0; i!=nr_i; i++) {
+            if (tdb[t][i])
+                h = (h ^ i) * prime;
+        }
+        h = (h ^ (classes.size() == 0 ? 2 : classes[t])) * prime;
+        h = (h ^ 0xff) * prime;
+    }
+    return h;
+}
+
+const Dataset& Dataset::get(const char* filename) {
+    std::lock_guard<std::mutex> lock(loading);
+    map<string, Dataset*>::iterator it = loaded.find(filename);
+    if (it != loaded.end())
+        return *(it->second);
+    Dataset* d = new Dataset(filename);
+    loaded[filename] = d;
+    return *d;
+}
+
+const Dataset* Dataset::find(const char* filename, string& error) {
+    std::lock_guard<std::mutex> lock(loading);
+    map<string, Dataset*>::iterator it = loaded.find(filename);
+    if (it != loaded.end())
+        return it->second;
+    Dataset* d = new Dataset(filename, &error);
+    if (error != "") {
+        delete d;
+        return NULL;
+    }
+    loaded[filename] = d;
+    return d;
+}
+
+void Dataset::put(const char* name, Dataset* d) {
+    std::lock_guard<std::mutex> lock(loading);
+    map<string, Dataset*>::iterator it = loaded.find(name);
+    if (it != loaded.end())
+        delete it->second;
+    loaded[name] = d;
+}
+
+#endif
@@ -0,0 +1,95 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_DATASET_HH__
+#define __FIMCP_COMMON_DATASET_HH__
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * \brief Transaction database
+ *
+ * The 0/1 matrix of transactions x items and the optional class label
+ * of every transaction, as read by Reader_Eliz.
+ *
+ * Datasets are loaded once per process: get() keeps every dataset it
+ * read, so that all models and engines share the same copy. get() may
+ * be called from several threads (see Server).
+ *
+ */
+class Dataset {
+public:
+  /// Number of transactions
+  int nr_t;
+  /// Number of items
+  int nr_i;
+  /// the matrix, tdb[t][i]
+  vector< vector<bool> > tdb;
+  /// class label of every transaction (empty if no labels)
+  vector<bool> classes;
+
+  /// Empty dataset
+  Dataset(void);
+  /// Read dataset from \a filename (annotated transaction format), a
+  /// bad file is reported in \a error if given, else it exits
+  Dataset(const char* filename, string* error = NULL);
+  /// Dataset of \a nr_items items with the item ids of every transaction
+  /// and optionally their class labels (library)
+  Dataset(int nr_items, const vector< vector<int> >& transactions,
+          const vector<bool>& labels = vector<bool>());
+
+  /// Fraction of ones in the matrix
+  float sparseness(void) const;
+  /// Number of positive transactions
+  int nr_pos(void) const;
+  /// Print the statistics line of the dataset named \a name
+  void print_info(const char* name, unsigned int freq) const;
+  /// Hash of the matrix and the labels (64 bit FNV-1a)
+  unsigned long long fingerprint(void) const;
+
+  /// Dataset of \a filename, read on first use
+  static const Dataset& get(const char* filename);
+  /// As get(), but NULL and the reason in \a error if it can not be read
+  static const Dataset* find(const char* filename, string& error);
+  /// Make \a d the dataset of \a name (takes ownership)
+  static void put(const char* name, Dataset* d);
+protected:
+  /// all loaded datasets
+  static map<string, Dataset*> loaded;
+};
+
+#endif
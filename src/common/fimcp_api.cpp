@@ -0,0 +1,276 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_API__
+#define __FIMCP_COMMON_API__
+
+#include "fimcp_api.hh"
+#include "fimcp_blocks.hh"
+#include "fimcp_eclat.hh"
+#include "fimcp_lcm.hh"
+
+#include <cmath>
+
+/// The classes of a space without labels
+static const vector<bool> no_classes;
+
+Fimcp_space::Fimcp_space(const Dataset& d, bool l) :
+    data(d),
+    items(*this, d.nr_i, 0, 1),
+    transactions(*this, d.nr_t, 0, 1),
+    labels(l) {
+    if (labels && data.classes.size() == 0)
+        throw Exception("Class label error", "the dataset has no class labels");
+
+    Block_home h(blocks());
+    Coverage_block::post(h, true);
+}
+
+Fimcp_space::Fimcp_space(bool share, Fimcp_space& s) :
+    Space(share, s),
+    data(s.data),
+    labels(s.labels) {
+    items.update(*this, share, s.items);
+    transactions.update(*this, share, s.transactions);
+}
+
+Space* Fimcp_space::copy(bool share) {
+    return new Fimcp_space(share, *this);
+}
+
+Block_home Fimcp_space::blocks(void) {
+    return Block_home(*this, items, transactions, data.tdb,
+                      (labels ? data.classes : no_classes));
+}
+
+int Fimcp_space::threshold(double v, int total) {
+    if (v < 1) {
+        // < 1 means relative value
+        return (int)(floor((v*total)+0.5)); // round(x)=floor(x+0.5)
+    } else {
+        return (int)v;
+    }
+}
+
+void Fimcp_space::post_closed(void) {
+    Block_home h(blocks());
+    Closed_block::post(h);
+}
+
+void Fimcp_space::post_deltaclosed(double delta) {
+    Block_home h(blocks());
+    Deltaclosed_block::post(h, delta);
+}
+
+void Fimcp_space::post_frequency(int minsupp) {
+    Block_home h(blocks());
+    Frequent_block::post(h, minsupp);
+}
+
+void Fimcp_space::post_maximal(int minsupp) {
+    Block_home h(blocks());
+    Maximal_block::post(h, minsupp);
+}
+
+void Fimcp_space::post_infrequency(int maxsupp) {
+    Block_home h(blocks());
+    Infrequent_block::post(h, maxsupp);
+}
+
+void Fimcp_space::post_size(IntRelType r, int n) {
+    Block_home h(blocks());
+    Size_block<>::post(h, r, n);
+}
+
+void Fimcp_space::post_cost(const vector<int>& cost, IntRelType r, int n) {
+    Block_home h(blocks());
+    Cost_block<>::post(h, cost, r, n);
+}
+
+void Fimcp_space::post_avgcost(const vector<int>& cost, IntRelType r, int n) {
+    Block_home h(blocks());
+    Avgcost_block<>::post(h, cost, r, n);
+}
+
+void Fimcp_space::post_branching(IntVarBranch var, IntValBranch val) {
+    branch(*this, items, var, val);
+}
+
+Fimcp_space* Fimcp_space::standard(const Dataset& d, int minsupp) {
+    Fimcp_space* s = new Fimcp_space(d);
+    s->post_frequency(minsupp);
+    s->post_branching();
+    return s;
+}
+
+Fimcp_space* Fimcp_space::closed(const Dataset& d, int minsupp) {
+    Fimcp_space* s = new Fimcp_space(d);
+    s->post_closed();
+    s->post_frequency(minsupp);
+    s->post_branching();
+    return s;
+}
+
+Fimcp_space* Fimcp_space::maximal(const Dataset& d, int minsupp) {
+    Fimcp_space* s = new Fimcp_space(d);
+    s->post_maximal(minsupp);
+    s->post_branching();
+    return s;
+}
+
+Fimcp_space* Fimcp_space::deltaclosed(const Dataset& d, int minsupp, double delta) {
+    Fimcp_space* s = new Fimcp_space(d);
+    s->post_deltaclosed(delta);
+    s->post_frequency(minsupp);
+    s->post_branching();
+    return s;
+}
+
+Fimcp_space* Fimcp_space::discriminating(const Dataset& d, int minsupp_pos, int maxsupp_neg) {
+    Fimcp_space* s = new Fimcp_space(d, true);
+    s->post_frequency(minsupp_pos);
+    s->post_infrequency(maxsupp_neg);
+    s->post_branching();
+    return s;
+}
+
+Fimcp_space* Fimcp_space::discriminating_deltaclosed(const Dataset& d, int minsupp_pos,
+                                                     int maxsupp_neg, double delta) {
+    Fimcp_space* s = new Fimcp_space(d, true);
+    s->post_deltaclosed(delta);
+    s->post_frequency(minsupp_pos);
+    s->post_infrequency(maxsupp_neg);
+    s->post_branching();
+    return s;
+}
+
+Fimcp_space* Fimcp_space::size(const Dataset& d, int minsupp, IntRelType r, int n) {
+    Fimcp_space* s = new Fimcp_space(d);
+    s->post_frequency(minsupp);
+    s->post_size(r, n);
+    s->post_branching();
+    return s;
+}
+
+Fimcp_space* Fimcp_space::cost(const Dataset& d, int minsupp, const vector<int>& cost,
+                               IntRelType r, int n) {
+    Fimcp_space* s = new Fimcp_space(d);
+    s->post_frequency(minsupp);
+    s->post_cost(cost, r, n);
+    s->post_branching();
+    return s;
+}
+
+Fimcp_space* Fimcp_space::avgcost(const Dataset& d, int minsupp, const vector<int>& cost,
+                                  IntRelType r, int n) {
+    Fimcp_space* s = new Fimcp_space(d);
+    s->post_frequency(minsupp);
+    s->post_avgcost(cost, r, n);
+    s->post_branching();
+    return s;
+}
+
+Fimcp_space* Fimcp_space::closed_cost(const Dataset& d, int minsupp, const vector<int>& cost,
+                                      IntRelType r, int n) {
+    Fimcp_space* s = new Fimcp_space(d);
+    s->post_closed();
+    s->post_frequency(minsupp);
+    s->post_cost(cost, r, n);
+    s->post_branching();
+    return s;
+}
+
+void Fimcp_space::solution(vector<int>& ids, int& supp, int& neg, vector<word_t>* tids) const {
+    ids.clear();
+    for (int i=0; i!=items.size(); i++) {
+        if (items[i].val() == 1)
+            ids.push_back(i);
+    }
+    supp = 0; neg = 0;
+    if (tids != NULL)
+        tids->assign(tidset_words(data.nr_t), 0);
+    for (int t=0; t!=transactions.size(); t++) {
+        if (transactions[t].val() == 0)
+            continue;
+        if (labels && !data.classes[t])
+            neg++;
+        else
+            supp++;
+        if (tids != NULL)
+            (*tids)[t/WORD_BITS] |= (word_t)1 << (t%WORD_BITS);
+    }
+}
+
+
+Fimcp_miner::Fimcp_miner(const Fimcp_callback& cb, bool t, double threads) :
+    callback(cb), tids(t), _nodes(0), _sols(0) {
+    so.threads = threads;
+    so.c_d = 0; // as the binaries: with branchval MAX less memory
+}
+
+unsigned long Fimcp_miner::search(Fimcp_space* s) {
+    DFS<Fimcp_space> e(s, so);
+    delete s;
+    vector<int> ids;
+    vector<word_t> set;
+    Fimcp_solution sol = { &ids, 0, 0, NULL };
+    _sols = 0;
+    while (Fimcp_space* found = e.next()) {
+        found->solution(ids, sol.support, sol.neg, (tids ? &set : NULL));
+        sol.tids = (tids ? &set[0] : NULL);
+        delete found;
+        _sols++;
+        if (!callback(sol))
+            break;
+    }
+    _nodes = e.statistics().node;
+    return _sols;
+}
+
+unsigned long Fimcp_miner::eclat(const Dataset& d, int minsupp) {
+    Fimcp_eclat engine(d, minsupp, callback, tids);
+    engine.run();
+    _nodes = engine.nr_nodes();
+    _sols = engine.nr_solutions();
+    return _sols;
+}
+
+unsigned long Fimcp_miner::lcm(const Dataset& d, int minsupp) {
+    Fimcp_lcm engine(d, minsupp, callback, tids);
+    engine.run();
+    _nodes = engine.nr_nodes();
+    _sols = engine.nr_solutions();
+    return _sols;
+}
+
+#endif
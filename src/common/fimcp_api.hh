@@ -0,0 +1,176 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_API_HH__
+#define __FIMCP_COMMON_API_HH__
+
+#include <vector>
+using namespace std;
+
+#include <gecode/int.hh>
+#include <gecode/search.hh>
+using namespace Gecode;
+
+#include "dataset.hh"
+#include "tidset.hh"
+#include "fimcp_callback.hh"
+
+struct Block_home;
+
+/**
+ * \brief %FIM-CP as a library: a model of itemset mining
+ *
+ * The same variables and constraint blocks as the fimcp_* binaries
+ * (the post() of the blocks in fimcp_blocks.hh), without options or
+ * output: a program builds its dataset, posts the
+ * blocks it needs (or uses one of the builders, one per binary) and
+ * searches it with a Fimcp_miner.
+ *
+ * Thresholds are absolute, Fimcp_space::threshold() converts a
+ * relative one as -freq does.
+ *
+ * Example, the closed itemsets of \a d with support at least 10%:
+ * \code
+ * Fimcp_miner m(print_it);
+ * m.search(Fimcp_space::closed(d, Fimcp_space::threshold(0.1, d.nr_t)));
+ * \endcode
+ *
+ */
+class Fimcp_space : public Space {
+protected:
+  /// the dataset (not copied)
+  const Dataset& data;
+  /// Item Variables
+  BoolVarArray items;
+  /// Transaction Variables
+  BoolVarArray transactions;
+  /// the class labels are used (discriminating models)
+  bool labels;
+  /// What the constraint blocks post on (see fimcp_blocks.hh)
+  Block_home blocks(void);
+
+public:
+  /// Items and transactions of \a data, with the coverage constraint;
+  /// with \a labels the class labels of \a data are used
+  Fimcp_space(const Dataset& data, bool labels = false);
+  /// Constructor for cloning \a s
+  Fimcp_space(bool share, Fimcp_space& s);
+  /// Perform copying during cloning
+  virtual Space* copy(bool share);
+
+  /// Absolute threshold of \a v (>1 is absolute, <1 relative to \a total)
+  static int threshold(double v, int total);
+
+  /** constraint blocks, see the binary of the same name **/
+  /// closed: no item can be added without losing support
+  void post_closed(void);
+  /// delta-closed: no item can be added without losing more than \a delta
+  /// of the support (of the positive transactions, with labels)
+  void post_deltaclosed(double delta);
+  /// support at least \a minsupp (of the positive transactions, with labels)
+  void post_frequency(int minsupp);
+  /// frequent and maximal: no item can be added without becoming infrequent
+  void post_maximal(int minsupp);
+  /// at most \a maxsupp negative transactions (with labels)
+  void post_infrequency(int maxsupp);
+  /// nr of items \a r \a n
+  void post_size(IntRelType r, int n);
+  /// sum of the \a cost of the items \a r \a n
+  void post_cost(const vector<int>& cost, IntRelType r, int n);
+  /// average \a cost of the items \a r \a n
+  void post_avgcost(const vector<int>& cost, IntRelType r, int n);
+  /// search on the items
+  void post_branching(IntVarBranch var = INT_VAR_DEGREE_MAX,
+                      IntValBranch val = INT_VAL_MAX);
+
+  /** builders, one per binary, branching included **/
+  static Fimcp_space* standard(const Dataset& d, int minsupp);
+  static Fimcp_space* closed(const Dataset& d, int minsupp);
+  static Fimcp_space* maximal(const Dataset& d, int minsupp);
+  static Fimcp_space* deltaclosed(const Dataset& d, int minsupp, double delta);
+  static Fimcp_space* discriminating(const Dataset& d, int minsupp_pos, int maxsupp_neg);
+  static Fimcp_space* discriminating_deltaclosed(const Dataset& d, int minsupp_pos,
+                                                 int maxsupp_neg, double delta);
+  static Fimcp_space* size(const Dataset& d, int minsupp, IntRelType r, int n);
+  static Fimcp_space* cost(const Dataset& d, int minsupp, const vector<int>& cost,
+                           IntRelType r, int n);
+  static Fimcp_space* avgcost(const Dataset& d, int minsupp, const vector<int>& cost,
+                              IntRelType r, int n);
+  static Fimcp_space* closed_cost(const Dataset& d, int minsupp, const vector<int>& cost,
+                                  IntRelType r, int n);
+
+  /// The solution of this (solved) space: its items, its support (of the
+  /// positive transactions, with labels) and negative support, and its
+  /// transactions in \a tids if not NULL
+  void solution(vector<int>& ids, int& supp, int& neg, vector<word_t>* tids) const;
+};
+
+/**
+ * \brief Runs searches, calling a Fimcp_callback for every solution
+ *
+ * Nothing is printed or written: every solution is handed to the
+ * callback, and the search stops early when the callback returns false.
+ * The native engines (-engine eclat/lcm) are available for the
+ * standard and closed itemsets of unlabelled datasets.
+ *
+ */
+class Fimcp_miner {
+protected:
+  /// gets the solutions
+  Fimcp_callback callback;
+  /// hand the transactions to the callback too
+  bool tids;
+  /// search options of the CP searches
+  Search::Options so;
+  /// statistics of the last search
+  unsigned long _nodes;
+  unsigned long _sols;
+public:
+  /// Miner calling \a cb, with the transactions if \a tids, searching
+  /// with \a threads threads (as -threads)
+  Fimcp_miner(const Fimcp_callback& cb, bool tids = false, double threads = 1.0);
+
+  /// Search all solutions of \a s (takes ownership), returns their number
+  unsigned long search(Fimcp_space* s);
+  /// Frequent itemsets of \a d with the native eclat engine
+  unsigned long eclat(const Dataset& d, int minsupp);
+  /// Closed frequent itemsets of \a d with the native LCM engine
+  unsigned long lcm(const Dataset& d, int minsupp);
+
+  /// Nr of search nodes of the last search
+  unsigned long nodes(void) const { return _nodes; }
+  /// Nr of solutions of the last search
+  unsigned long solutions(void) const { return _sols; }
+};
+
+#endif
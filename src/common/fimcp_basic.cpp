@@ -36,16 +36,58 @@
 #define _FILE_OFFSET_BITS  64
 
 #include "fimcp_basic.hh"
+#include "fimcp_blocks.hh"
+#include "hybrid.hh"
 #include "textoption.hh"
 #include "stringuintoption.hh"
 #include "floatoption.hh"
-#include "reader_eliz.cpp"
+#include "phases.hh"
+#include "progress.hh"
+#include "tree_shape.hh"
+#include "budget_search.hh"
+#include "checkpoint.hh"
+
+#include <algorithm>
+
+/// Solution writer, shared by all spaces and closed at exit
+static SolutionWriter* solwriter = NULL;
+static void close_solutions(void) {
+    if (solwriter == NULL)
+        return;
+    solwriter->close();
+    if (solwriter->ring_buffers() != 0)
+        fprintf(stdout, " output ring: %lu buffers written, full %lu times\n",
+                solwriter->ring_buffers(), solwriter->ring_stalls());
+}
+
+/// Writer of the request served by this thread, if any (see Server)
+static thread_local SolutionWriter* request_writer = NULL;
 
 /// Constructor for creation
-Fimcp_basic::Fimcp_basic(const Options_fimcp& opt) :
-        print_itemsets(PRINT_NONE), solfile(stdout) {
+Fimcp_basic::Fimcp_basic(const Options_fimcp& opt, int phase0) :
+        print_itemsets(PRINT_NONE), solfile(stdout), writer(NULL),
+        phase(phase0), progress_depth(-1), progress_done(0) {
+    Phases::Timer timer(Phases::POST);
     // all stuff implemented in ::run
     run(opt);
+    // after ::run, the classes are final
+    post_support();
+    if (opt.supp_below() != 0 && support.size() != 0) {
+        // only the supports not in the result store (see ResultStore)
+        rel(*this, support[0], IRT_LE, opt.supp_below());
+    }
+    if (phase == PHASE_ALL)
+        writer->put_header(print_itemsets, (classes.size() != 0), nr_i, nr_t);
+}
+
+/// Post the setting \a opt on this clone of a base, writing to \a w
+void Fimcp_basic::setting(const Options_fimcp& opt, SolutionWriter* w) {
+    Phases::Timer timer(Phases::POST);
+    phase = PHASE_SETTING;
+    writer = w;
+    solfile = w->file();
+    run(opt);
+    writer->put_header(print_itemsets, (classes.size() != 0), nr_i, nr_t);
 }
 
 /// Model must be implemented in this function.
@@ -57,54 +99,170 @@ Fimcp_basic::Fimcp_basic(bool share, Fimcp_basic& s) :
     Script(share,s),
     print_itemsets(s.print_itemsets),
     solfile(s.solfile),
+    writer(s.writer),
     nr_i(s.nr_i),
     nr_t(s.nr_t),
-    classes(s.classes) {
+    ones(s.ones),
+    classes(s.classes),
+    phase(s.phase),
+    progress_depth(s.progress_depth),
+    progress_done(s.progress_done) {
     transactions.update(*this, share, s.transactions);
     items.update(*this, share, s.items);
+    support.update(*this, share, s.support);
+    if (Progress::enabled())
+        progress(s);
 }
 
-/// Do common construction stuff
-const vector< vector<bool> > Fimcp_basic::common_construction(const Options_fimcp& opt) {
-
-    // Read data
-    Reader_Eliz<bool> data;
-    data.read(opt.datafile()); 
+/// Account for this clone of \a s in the progress
+void Fimcp_basic::progress(Fimcp_basic& s) {
+    static thread_local unsigned int seen = 0;
+    static thread_local unsigned long branchings = 0;
+    if (s.progress_depth < 0) {
+        // the copy of the root by the engine
+        progress_depth = 0;
+        return;
+    }
+    // a branching: the engine keeps this clone for the second
+    // alternative, s continues with the first
+    progress_depth = ++s.progress_depth;
+    progress_done = s.progress_done + ldexp(1.0, -progress_depth);
+    branchings++;
+    if (Progress::due(seen)) {
+        // every branching has two children
+        Progress::sample(2*branchings, s.progress_depth, s.progress_done);
+        branchings = 0;
+    }
+}
 
-    const vector< vector<bool> >& tdb = data.data;
-    classes = data.classes;
-    nr_t = tdb.size();
-    nr_i = tdb[0].size();
-
-    // output stuff
-    if (opt.output() == OUT_FIMI)
-        print_itemsets = PRINT_FIMI;
-    else if (opt.output() == OUT_FULL)
-        print_itemsets = PRINT_FULL;
-    else if (opt.output() == OUT_CPVARS)
-        print_itemsets = PRINT_CPVARS;
+/// Print style selected by \a opt
+PrintStyle Fimcp_basic::print_style(const Options_fimcp& opt) {
 #ifdef GECODE_HAS_GIST
     if (opt.mode() == SM_GIST)
-        print_itemsets = PRINT_CPVARS;
+        return PRINT_CPVARS;
 #endif
-    if (strcmp(opt.solfile(),"") != 0) { // solfile != ""
+    switch (opt.output()) {
+    case OUT_FIMI: return PRINT_FIMI;
+    case OUT_FULL: return PRINT_FULL;
+    case OUT_CPVARS: return PRINT_CPVARS;
+    case OUT_BINARY: return PRINT_BINARY;
+    case OUT_BINFULL: return PRINT_BINFULL;
+    case OUT_DELTA: return PRINT_DELTA;
+    default: return PRINT_NONE;
+    }
+}
+
+/// Solution writer for \a opt, opened once and shared by everyone
+SolutionWriter* Fimcp_basic::solution_writer(const Options_fimcp& opt) {
+    if (request_writer != NULL)
+        return request_writer;
+    if (solwriter != NULL)
+        return solwriter;
+
+    if (strcmp(opt.solfile(),"") == 0) { // solfile == ""
+        // stdout is shared with the search summary: flush every solution
+        solwriter = new SolutionWriter(stdout, true);
+    } else {
         fprintf(stdout, "writing solutions to file %s\n", opt.solfile());
-        solfile = fopen(opt.solfile(),"w");
-        if (solfile == NULL)
+        PrintStyle style = print_style(opt);
+        FILE* f;
+        if (Checkpoint::resuming())
+            f = fopen(opt.solfile(),"r+b");
+        else if (style == PRINT_BINARY || style == PRINT_BINFULL)
+            f = fopen(opt.solfile(),"wb");
+        else
+            f = fopen(opt.solfile(),"w");
+        if (f == NULL)
           throw Exception("Solution file", "Can not open solution file");
+        solwriter = new SolutionWriter(f, false, 1<<20, opt.outring());
+        if (Checkpoint::resuming())
+            Checkpoint::resume(solwriter);
     }
-    //fprintf(stdout, " dataset %s: %ix%i:%1.2f freq is %i\n", opt.datafile(), nr_t, nr_i, getSparseness(tdb), opt.getFreq(nr_t));
-    fprintf(stdout, " dataset %s: %ix%i:%1.2f", opt.datafile(), nr_t, nr_i, getSparseness(tdb));
-    if (classes.size() != 0) {
-        int posTot = 0;
-        for (int t = 0; t!=nr_t;t++ )
-            posTot += classes[t];
-        fprintf(stdout, " %i:+%i-%i", nr_t, posTot, (nr_t-posTot));
+    atexit(close_solutions);
+    return solwriter;
+}
+
+/// Write the solutions found by this thread to \a w (NULL: the normal writer)
+void Fimcp_basic::serving(SolutionWriter* w) {
+    request_writer = w;
+}
+
+/// Search the model for \a opt
+void Fimcp_basic::solve(const Options_fimcp& opt) {
+    Phases::Timer timer(Phases::SEARCH);
+    if (strcmp(opt.shape(),"") != 0 || strcmp(opt.trace(),"") != 0) {
+        if (strcmp(opt.store(),"") != 0 || opt.hybrid()) {
+            fprintf(stderr, "\tError: -shape and -trace can not be used with -store or -hybrid !\n");
+            exit(1);
+        }
+        Tree_shape::run(opt);
+        return;
+    }
+    if (request_writer == NULL) {
+        // the counts assume the clones of DFS, Budget_search clones otherwise
+        if (opt.c_d() > 1 || opt.threads() != 1 || opt.membudget() != 0 ||
+            Checkpoint::enabled())
+            Progress::approximate();
+        if (opt.membudget() != 0 || Checkpoint::enabled()) {
+            if (Checkpoint::enabled() && (strcmp(opt.store(),"") != 0 || opt.hybrid())) {
+                fprintf(stderr, "\tError: -checkpoint can not be used with -store or -hybrid !\n");
+                exit(1);
+            }
+            Budget_search::run(opt);
+            Progress::disable();
+            Checkpoint::finish();
+            return;
+        }
+        Script::run<Fimcp_basic,DFS,Options_fimcp>(opt);
+        Progress::disable();
+        return;
+    }
+    // a request: the driver is not thread safe, the summary goes to the log
+    Support::Timer t;
+    t.start();
+    Fimcp_basic* s = new Fimcp_basic(opt);
+    Search::Options so;
+    so.threads = opt.threads();
+    so.c_d = opt.c_d();
+    so.a_d = opt.a_d();
+    DFS<Fimcp_basic> e(s, so);
+    delete s;
+    unsigned long sols = 0;
+    while (Fimcp_basic* sol = e.next()) {
+        sol->print(std::cout);
+        delete sol;
+        if ((++sols == opt.solutions() && opt.solutions() != 0) || request_writer->failed())
+            break;
     }
-    if (opt.getFreq(nr_t) != 0)
-        fprintf(stdout, " minfreq %i\n", opt.getFreq(nr_t));
-    else
-        fprintf(stdout, "\n");
+    Search::Statistics stat = e.statistics();
+    fprintf(stdout, " %s: %lu solutions in %.3f ms, %lu nodes, %lu failures\n",
+            opt.name(), sols, t.stop(), stat.node, stat.fail);
+}
+
+/// Do common construction stuff
+const vector< vector<bool> > Fimcp_basic::common_construction(const Options_fimcp& opt) {
+
+    // Read data (once)
+    const Dataset& data = Dataset::get(opt.datafile());
+
+    // the copy of the matrix of the model, its variables
+    Phases::Timer timer(Phases::MATRIX);
+    const vector< vector<bool> >& tdb = data.tdb;
+    if (phase == PHASE_SETTING) {
+        // vars, classes and output are those of the base
+        return tdb;
+    }
+    classes = data.classes;
+    nr_t = data.nr_t;
+    nr_i = data.nr_i;
+
+    // output stuff, a batch opens its own writers
+    print_itemsets = print_style(opt);
+    if (phase == PHASE_ALL) {
+        writer = solution_writer(opt);
+        solfile = writer->file();
+    }
+    data.print_info(opt.datafile(), opt.getFreq(nr_t));
 
     // init vars
     transactions = BoolVarArray(*this, nr_t, 0, 1);
@@ -113,15 +271,26 @@ const vector< vector<bool> > Fimcp_basic::common_construction(const Options_fimc
     return tdb;
 }
 
-/// Calculate sparseness of matrix
-inline
-float Fimcp_basic::getSparseness(const vector< vector<bool> >& tdb) {
-    int sum = 0;
-    for (int t=0; t!=nr_t; t++) {
-        for (int i=0; i!=nr_i; i++)
-            sum += tdb[t][i];
+const vector< vector<bool> > Fimcp_basic::model_construction(const Options_fimcp& opt, bool labels) {
+    const vector< vector<bool> > tdb = common_construction(opt);
+    if (!labels && classes.size() != 0) {
+        classes.resize(0);
+        fprintf(stdout, " Warning: class labels found, ignored.\n");
+    }
+    if (labels && classes.size() == 0)
+        throw Exception("Class label error", "no class labels found");
+    return tdb;
+}
+
+void Fimcp_basic::post_search(const Options_fimcp& opt, Block_home& home, bool linear) {
+    if (opt.hybrid() && home.side.size() != 0) {
+        if (linear) {
+            if (hybrid(*this, opt, items, transactions, home.tdb, home.side, print_itemsets, writer))
+                return;
+        } else
+            fprintf(stdout, " Warning: -hybrid needs a model of frequency and size or cost only, ignored.\n");
     }
-    return ((float)sum/(nr_i*nr_t));
+    branch(*this, items, (IntVarBranch)opt.branching(), (IntValBranch)opt.branchval());
 }
 
 /// Post coverage using the CLAUSE constraint
@@ -145,65 +314,171 @@ void Fimcp_basic::coverage_clause(const vector< vector<bool> >& tdb) {
     }
 }
 
+/**
+ * \brief Keeps Fimcp_basic::ones up to date, so print() does not go
+ * over all items: an advisor on every free item adds it when it is set
+ * to 1, and goes away once the item is assigned
+ *
+ * It never propagates.
+ *
+ */
+class ItemsIn : public Propagator {
+protected:
+  /// Advisor of item \a i
+  class Item : public Advisor {
+  public:
+    Int::BoolView x;
+    int i;
+    Item(Space& home, Propagator& p, Council<Item>& c, Int::BoolView x0, int i0)
+      : Advisor(home, p, c), x(x0), i(i0) {}
+    Item(Space& home, bool share, Item& a)
+      : Advisor(home, share, a), i(a.i) {
+      x.update(home, share, a.x);
+    }
+  };
+  /// the advisors of the free items
+  Council<Item> c;
+
+  /// Constructor for cloning \a p
+  ItemsIn(Space& home, bool share, ItemsIn& p)
+    : Propagator(home, share, p) {
+    c.update(home, share, p.c);
+  }
+public:
+  /// Constructor for creation, on the free \a items
+  ItemsIn(Home home, const BoolVarArray& items)
+    : Propagator(home), c(home) {
+    for (int i=0; i!=items.size(); i++) {
+      Int::BoolView x(items[i]);
+      if (x.none())
+        x.subscribe(home, *new (home) Item(home, *this, c, x, i));
+    }
+  }
+  /// Item \a a is assigned
+  virtual ExecStatus advise(Space& home, Advisor& _a, const Delta& d) {
+    Item& a = static_cast<Item&>(_a);
+    if (Int::BoolView::one(d))
+      static_cast<Fimcp_basic&>(home).ones.push_back(a.i);
+    return home.ES_FIX_DISPOSE(c, a);
+  }
+  virtual ExecStatus propagate(Space&, const ModEventDelta&) {
+    return ES_FIX;
+  }
+  virtual PropCost cost(const Space&, const ModEventDelta&) const {
+    return PropCost::unary(PropCost::LO);
+  }
+  virtual Actor* copy(Space& home, bool share) {
+    return new (home) ItemsIn(home, share, *this);
+  }
+  virtual size_t dispose(Space& home) {
+    for (Advisors<Item> a(c); a(); ++a)
+      a.advisor().x.cancel(home, a.advisor());
+    c.dispose(home);
+    (void) Propagator::dispose(home);
+    return sizeof(*this);
+  }
+};
+
+/// Post the support counters and the list of items read by print()
+void Fimcp_basic::post_support(void) {
+    if (print_itemsets == PRINT_NONE || print_itemsets == PRINT_CPVARS)
+        return;
+
+    // the items in so far, ItemsIn adds the others
+    for (int i=0; i!=nr_i; i++) {
+        if (items[i].one())
+            ones.push_back(i);
+    }
+    if (!failed())
+        (void) new (*this) ItemsIn(*this, items);
+
+    if (classes.size() == 0) {
+        // supp = sum(Trans)
+        support = IntVarArray(*this, 1, 0, nr_t);
+        linear(*this, transactions, IRT_EQ, support[0]);
+    } else { // labels are used
+        int posTot = 0;
+        for (int t=0; t!=nr_t; t++)
+            posTot += classes[t];
+        BoolVarArgs pos(posTot);
+        BoolVarArgs neg(nr_t-posTot);
+        int p = 0; int n = 0;
+        for (int t=0; t!=nr_t; t++) {
+            if (classes[t])
+                pos[p++] = transactions[t];
+            else
+                neg[n++] = transactions[t];
+        }
+        // pos = sum(Trans_pos), neg = sum(Trans_neg)
+        support = IntVarArray(*this, 2, 0, nr_t);
+        linear(*this, pos, IRT_EQ, support[0]);
+        linear(*this, neg, IRT_EQ, support[1]);
+    }
+}
+
 /// Print solution
 void Fimcp_basic::print(std::ostream& os) const {
+    Phases::Timer timer(Phases::PRINT);
+    Progress::solution();
     if (print_itemsets == PRINT_NONE) {
         return;
-    } else if (print_itemsets == PRINT_FIMI) {
-        // FIMI style output
-        for (int i=0; i!=nr_i; i++) {
-            if (items[i].val() == 1)
-                fprintf(solfile, "%i ", i);
-        }
-        if (classes.size() == 0) {
-            unsigned int supp = 0;
-            for (int t=0; t!=nr_t; t++)
-                supp += transactions[t].val();
-            fprintf(solfile, "(%i)\n", supp);
-        } else { // labels are used
-            int pos = 0; int neg = 0;
-            for (int t=0; t!=nr_t; t++) {
-                if (classes[t])
-                    pos += transactions[t].val();
-                else
-                    neg += transactions[t].val();
-            }
-            fprintf(solfile, "(%i:+%i-%i)\n", (pos+neg), pos, neg);
-        }
-    } else if (print_itemsets == PRINT_FULL) {
-        // FULL output, items and transactions
-        for (int i=0; i!=nr_i; i++) {
-            if (items[i].val() == 1)
-                fprintf(solfile, "%i ", i);
-        }
-        if (classes.size() == 0) {
-            unsigned int supp = 0;
-            for (int t=0; t!=nr_t; t++)
-                supp += transactions[t].val();
-            fprintf(solfile, "(%i) < ", supp);
-            for (int t=0; t!=nr_t; t++)
-                if (transactions[t].val() == 1)
-                    fprintf(solfile, "%i ", t);
-            fprintf(solfile, ">\n");
-        } else { // labels are used
-            int pos = 0; int neg = 0;
-            for (int t=0; t!=nr_t; t++) {
-                if (classes[t])
-                    pos += transactions[t].val();
-                else
-                    neg += transactions[t].val();
-            }
-            fprintf(solfile, "(%i:+%i-%i) < ", (pos+neg), pos, neg);
-            for (int t=0; t!=nr_t; t++)
-                if (transactions[t].val() == 1)
-                    fprintf(solfile, "%i ", t);
-            fprintf(solfile, ">\n");
-        }
     } else if (print_itemsets == PRINT_CPVARS) {
         // Output CP variables (mostly for GIST)
         os << "\tI[] = " << items << std::endl;
         os << "\tT[] = " << transactions << std::endl;
+    } else {
+        // only the items (and transactions) that are in
+        SolutionWriter& w = *writer;
+        vector<int>& ids = w.scratch_items();
+        ids.assign(ones.begin(), ones.end());
+        std::sort(ids.begin(), ids.end());
+        vector<int>& tids = w.scratch_tids();
+        tids.clear();
+        if (print_itemsets == PRINT_FULL || print_itemsets == PRINT_BINFULL) {
+            for (int t=0; t!=nr_t; t++) {
+                if (transactions[t].one())
+                    tids.push_back(t);
+            }
+        }
+        if (classes.size() == 0)
+            w.put_solution(print_itemsets, ids, false, support[0].val(), 0, tids, nr_t);
+        else // labels are used
+            w.put_solution(print_itemsets, ids, true, support[0].val(), support[1].val(), tids, nr_t);
+    }
+}
+
+/// First item that is not assigned yet, -1 if none
+int Fimcp_basic::unassigned_item(void) const {
+    for (int i=0; i!=items.size(); i++) {
+        if (!items[i].assigned())
+            return i;
     }
+    return -1;
+}
+
+/// Assign item \a i to \a v
+void Fimcp_basic::assign_item(int i, int v) {
+    rel(*this, items[i], IRT_EQ, v);
+}
+
+/// Nr of assigned item and transaction variables
+int Fimcp_basic::assigned(void) const {
+    int n = 0;
+    for (int i=0; i!=items.size(); i++)
+        n += items[i].assigned();
+    for (int t=0; t!=transactions.size(); t++)
+        n += transactions[t].assigned();
+    return n;
+}
+
+/// Nr of unassigned items and of transactions not assigned to 0
+void Fimcp_basic::shape(int& unfixed, int& covered) const {
+    unfixed = 0;
+    for (int i=0; i!=items.size(); i++)
+        unfixed += !items[i].assigned();
+    covered = 0;
+    for (int t=0; t!=transactions.size(); t++)
+        covered += !transactions[t].zero();
 }
 
 #endif
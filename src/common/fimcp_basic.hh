@@ -41,14 +41,18 @@ using namespace std;
 #include <gecode/driver.hh>
 using namespace Gecode::Driver;
 #include "options_fimcp.cpp"
+#include "solution_writer.hh"
+#include "dataset.hh"
 
-enum PrintStyle {
-    PRINT_NONE,
-    PRINT_FIMI,
-    PRINT_FULL,
-    PRINT_CPVARS
+/// What Fimcp_basic::run() posts: everything, or one half of a batch model
+enum Phase {
+  PHASE_ALL,     ///< the complete model
+  PHASE_BASE,    ///< only what does not depend on the thresholds (see Batch)
+  PHASE_SETTING  ///< only the thresholds and the search, on a clone of the base
 };
 
+struct Block_home;
+
 /**
  * %FIM-CP: Frequent Itemset Mining in CP, base class.
  *
@@ -66,6 +70,8 @@ protected:
   PrintStyle print_itemsets;
   /// file to print to, if any
   FILE* solfile;
+  /// buffered writer on solfile, shared by all clones
+  SolutionWriter* writer;
 
   /// Number of items
   int nr_i;
@@ -75,13 +81,31 @@ protected:
   BoolVarArray transactions;
   /// Item Variables
   BoolVarArray items;
+  /// Support counters for printing: [supp] or [pos,neg] (see post_support)
+  IntVarArray support;
+  /// Items assigned 1, in the order they were (see post_support)
+  vector<int> ones;
+  friend class ItemsIn;
 
   // saves the class of every transaction (optional)
   vector<bool> classes;
 
+  /// Which constraints run() posts, see Phase
+  int phase;
+  /// Decisions on the path to this space (-1: the root, not cloned yet)
+  /// and the fraction of the search tree done before it (see Progress)
+  int progress_depth;
+  double progress_done;
+  /// Account for this clone of \a s in the progress
+  void progress(Fimcp_basic& s);
+  /// Post the constraints that do not depend on the thresholds?
+  bool posting_base(void) const { return phase != PHASE_SETTING; }
+  /// Post the threshold constraints and the search?
+  bool posting_setting(void) const { return phase != PHASE_BASE; }
+
 public:
-  /// Constructor for creation
-  Fimcp_basic(const Options_fimcp&);
+  /// Constructor for creation, of the whole model or of one \a phase
+  Fimcp_basic(const Options_fimcp&, int phase = PHASE_ALL);
 
   /// Constructor for cloning \a s
   Fimcp_basic(bool, Fimcp_basic&);
@@ -93,20 +117,54 @@ public:
 
   /// Do common construction stuff
   const vector< vector<bool> > common_construction(const Options_fimcp&);
+  /// Common construction for a model that uses the class \a labels or
+  /// not: errors without them, ignores them (with a warning) if not used
+  const vector< vector<bool> > model_construction(const Options_fimcp&, bool labels);
+  /// Post the compiled \a Model of a fimcp_* binary (see fimcp_blocks.hh)
+  template<class Model>
+  void post_model(const Options_fimcp&);
+  /// Post the search on the model posted on \a home: -hybrid if the model
+  /// is \a linear, else the branching
+  void post_search(const Options_fimcp&, Block_home& home, bool linear);
 
   /// Get frequency to use
   int getFreq(const Options_fimcp&);
 
-  /// Calculate sparseness of matrix
-  float getSparseness(const vector< vector<bool> >&);
-  
   /// Post coverage using the CLAUSE constraint
   void coverage_clause(const vector< vector<bool> >& tdb);
 
+  /// Post the support counters and the list of items read by print()
+  void post_support(void);
+
+  /// Print style selected by \a opt
+  static PrintStyle print_style(const Options_fimcp&);
+
+  /// Solution writer for \a opt, opened once and shared by everyone
+  /// (or the writer of the request served by this thread, see Server)
+  static SolutionWriter* solution_writer(const Options_fimcp&);
+  /// Write the solutions found by this thread to \a w (NULL: the normal writer)
+  static void serving(SolutionWriter* w);
+
+  /// Search the model for \a opt: with the Gecode driver, or in this
+  /// thread when serving a request
+  static void solve(const Options_fimcp&);
+
   virtual void run(const Options_fimcp&);
 
+  /// Post the setting \a opt on this clone of a base, writing to \a w
+  void setting(const Options_fimcp&, SolutionWriter* w);
+
   /// Print a solution to \a os
   virtual void print(std::ostream&) const;
+
+  /// First item that is not assigned yet, -1 if none (see Block_profile)
+  int unassigned_item(void) const;
+  /// Assign item \a i to \a v (see Block_profile)
+  void assign_item(int i, int v);
+  /// Nr of assigned item and transaction variables (see Block_profile)
+  int assigned(void) const;
+  /// Nr of unassigned items and of transactions not assigned to 0 (see Tree_shape)
+  void shape(int& unfixed, int& covered) const;
 };
 
 #endif
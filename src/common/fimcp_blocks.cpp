@@ -0,0 +1,206 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_BLOCKS__
+#define __FIMCP_COMMON_BLOCKS__
+
+#include "fimcp_blocks.hh"
+
+#include <cstring>
+
+template struct Fimcp_model<Frequent_block>;
+template struct Fimcp_model<Closed_block, Frequent_block>;
+template struct Fimcp_model<Maximal_block>;
+template struct Fimcp_model<Deltaclosed_block, Frequent_block>;
+template struct Fimcp_model<Frequent_block, Infrequent_block>;
+template struct Fimcp_model<Deltaclosed_block, Frequent_block, Infrequent_block>;
+template struct Fimcp_model<Frequent_block, Emerging_block>;
+template struct Fimcp_model<Frequent_block, Size_block<1> >;
+template struct Fimcp_model<Frequent_block, Cost_block<1> >;
+template struct Fimcp_model<Frequent_block, Avgcost_block<1> >;
+template struct Fimcp_model<Closed_block, Frequent_block, Cost_block<1> >;
+
+/// A compiled combination, by canonical name
+struct Compiled {
+  const char* name;
+  Fimcp_blocks::Post base;
+  Fimcp_blocks::Post setting;
+};
+static const Compiled compiled_models[] = {
+  {"standard", &Standard_model::post_base, &Standard_model::post_setting},
+  {"closed", &Closed_model::post_base, &Closed_model::post_setting},
+  {"maximal", &Maximal_model::post_base, &Maximal_model::post_setting},
+  {"deltaclosed", &Deltaclosed_model::post_base, &Deltaclosed_model::post_setting},
+  {"discriminating", &Discriminating_model::post_base, &Discriminating_model::post_setting},
+  {"deltaclosed+discriminating", &Discriminating_deltaclosed_model::post_base,
+                                 &Discriminating_deltaclosed_model::post_setting},
+  {"emerging", &Emerging_model::post_base, &Emerging_model::post_setting},
+  {"size", &Size_model::post_base, &Size_model::post_setting},
+  {"cost", &Cost_model::post_base, &Cost_model::post_setting},
+  {"avgcost", &Avgcost_model::post_base, &Avgcost_model::post_setting},
+  {"closed+cost", &Closed_cost_model::post_base, &Closed_cost_model::post_setting},
+};
+
+/// The blocks of a spec, in canonical (posting) order
+static const char* const block_names[] = {
+  "closed", "deltaclosed", "maximal", "discriminating", "emerging", "size", "cost", "avgcost"
+};
+enum {B_CLOSED, B_DELTACLOSED, B_MAXIMAL, B_DISCRIMINATING, B_EMERGING, B_SIZE, B_COST, B_AVGCOST, B_NR};
+
+/// The blocks used by \a spec, false and the reason in \a error if it is not valid
+static bool parse_spec(const char* spec, vector<bool>& used, string& error) {
+    used.assign(B_NR, false);
+    string s(spec);
+    size_t start = 0;
+    while (start <= s.size()) {
+        size_t end = s.find('+', start);
+        if (end == string::npos)
+            end = s.size();
+        string b = s.substr(start, end-start);
+        int k = 0;
+        while (k != B_NR && b != block_names[k])
+            k++;
+        if (k != B_NR) {
+            used[k] = true;
+        } else if (b != "standard") {
+            error = "unknown block '" + b + "' in -model " + spec;
+            return false;
+        }
+        start = end+1;
+    }
+    if (used[B_SIZE] + used[B_COST] + used[B_AVGCOST] > 2) {
+        error = "at most two of size, cost and avgcost in -model (-bound1, -bound2)";
+        return false;
+    }
+    return true;
+}
+
+bool Fimcp_blocks::valid(const char* spec, string& error) {
+    vector<bool> used;
+    return parse_spec(spec, used, error);
+}
+
+string Fimcp_blocks::spec(const Options_fimcp& opt) {
+    string name(opt.name());
+    size_t slash = name.find_last_of("/\\");
+    if (slash != string::npos)
+        name = name.substr(slash+1);
+    // the all-in-one binary fimcp takes -model
+    return (name.compare(0, 6, "fimcp_") == 0 ? name.substr(6) : string(opt.model()));
+}
+
+Fimcp_blocks::Fimcp_blocks(const char* spec) :
+    _labels(false), _maximal(false), _linear(true), _attributes(false),
+    base(NULL), setting(NULL) {
+    // which blocks
+    vector<bool> used;
+    string error;
+    if (!parse_spec(spec, used, error)) {
+        fprintf(stderr, "\tError: %s !\n", error.c_str());
+        exit(1);
+    }
+
+    // canonical name
+    for (int k=0; k!=B_NR; k++) {
+        if (used[k])
+            _name += (_name.empty() ? "" : "+") + string(block_names[k]);
+    }
+    if (_name.empty())
+        _name = "standard";
+    _labels = used[B_DISCRIMINATING] || used[B_EMERGING];
+    _maximal = used[B_MAXIMAL];
+    _linear = !(used[B_CLOSED] || used[B_DELTACLOSED] || used[B_MAXIMAL] || _labels);
+    _attributes = used[B_COST] || used[B_AVGCOST];
+
+    // one by one, in the same order as Fimcp_model
+    add<Coverage_block>("coverage");
+    if (used[B_CLOSED])
+        add<Closed_block>("closed");
+    if (used[B_DELTACLOSED])
+        add<Deltaclosed_block>("deltaclosed");
+    if (used[B_MAXIMAL])
+        add<Maximal_block>("maximal");
+    else
+        add<Frequent_block>("frequency");
+    if (used[B_DISCRIMINATING])
+        add<Infrequent_block>("infrequency");
+    if (used[B_EMERGING])
+        add<Emerging_block>("emerging");
+    int bound = 1;
+    if (used[B_SIZE]) {
+        if (bound++ == 1)
+            add< Size_block<1> >("size");
+        else
+            add< Size_block<2> >("size");
+    }
+    if (used[B_COST]) {
+        if (bound++ == 1)
+            add< Cost_block<1> >("cost");
+        else
+            add< Cost_block<2> >("cost");
+    }
+    if (used[B_AVGCOST]) {
+        if (bound++ == 1)
+            add< Avgcost_block<1> >("avgcost");
+        else
+            add< Avgcost_block<2> >("avgcost");
+    }
+
+    // compiled?
+    for (unsigned int m=0; m!=sizeof(compiled_models)/sizeof(Compiled); m++) {
+        if (_name == compiled_models[m].name) {
+            base = compiled_models[m].base;
+            setting = compiled_models[m].setting;
+        }
+    }
+}
+
+void Fimcp_blocks::post_base(Block_home& h, const Options_fimcp& opt) const {
+    if (base != NULL) {
+        base(h, opt);
+        return;
+    }
+    for (unsigned int k=0; k!=bases.size(); k++)
+        bases[k](h, opt);
+}
+
+void Fimcp_blocks::post_setting(Block_home& h, const Options_fimcp& opt) const {
+    if (setting != NULL) {
+        setting(h, opt);
+        return;
+    }
+    for (unsigned int k=0; k!=settings.size(); k++)
+        settings[k](h, opt);
+}
+
+#endif
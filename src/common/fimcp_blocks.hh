@@ -0,0 +1,509 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_BLOCKS_HH__
+#define __FIMCP_COMMON_BLOCKS_HH__
+
+#include <string>
+#include <vector>
+using namespace std;
+
+#include "fimcp_basic.hh"
+#include "hybrid.hh"
+#include "reader_ssv.cpp"
+
+#ifndef PRECISION
+#define PRECISION 1000 // 3 numbers after comma
+#endif
+
+/**
+ * \brief The constraint blocks of the models, as policy classes
+ *
+ * Every block of the fimcp_* binaries is a class with two static
+ * functions: post_base() posts what does not depend on the thresholds
+ * (shared by all settings of a batch, see Batch) and post_setting() the
+ * rest. Both call the block its post(), which takes the thresholds
+ * explicitly and is also what the library posts (see Fimcp_space). A
+ * model is a Fimcp_model of blocks, composed at compile time so that the
+ * construction loops of all its blocks are inlined into one function.
+ *
+ * The fimcp binary combines the blocks named by -model, eg
+ * "closed+cost": the combinations of the fimcp_* binaries are explicitly
+ * instantiated (see fimcp_blocks.cpp), any other combination is composed
+ * at runtime from the same blocks (see Fimcp_blocks).
+ *
+ * Blocks of a labelled model (discriminating, emerging) count the
+ * frequency on the positive transactions only. The traits uses_labels
+ * and only_linear of a block say whether it needs the class labels and
+ * whether -hybrid can search it.
+ *
+ */
+
+/// What a block posts on: the variables and data of a Fimcp_basic
+struct Block_home {
+  Space& home;
+  BoolVarArray& items;
+  BoolVarArray& transactions;
+  const vector< vector<bool> >& tdb;
+  /// class labels, empty if the model does not use them
+  const vector<bool>& classes;
+  int nr_i;
+  int nr_t;
+  /// nr of positive transactions (nr_t without labels)
+  int nr_pos;
+  /// linear side constraints on the items, for -hybrid
+  vector<HybridSide> side;
+
+  Block_home(Space& h, BoolVarArray& i, BoolVarArray& t,
+             const vector< vector<bool> >& d, const vector<bool>& c) :
+      home(h), items(i), transactions(t), tdb(d), classes(c),
+      nr_i(i.size()), nr_t(t.size()), nr_pos(t.size()) {
+    if (classes.size() != 0) {
+      nr_pos = 0;
+      for (int t=0; t!=nr_t; t++)
+        nr_pos += classes[t];
+    }
+  }
+  /// Is transaction \a t counted for the frequency?
+  bool counted(int t) const {
+    return classes.size() == 0 || classes[t];
+  }
+};
+
+/// Operator and value of -bound1 (\a B = 1) or -bound2 (\a B = 2)
+template<int B>
+struct Bound {
+  static IntRelType op(const Options_fimcp& opt) {
+    return (IntRelType)(B == 1 ? opt.bound1_op() : opt.bound2_op());
+  }
+  static int val(const Options_fimcp& opt) {
+    return (int)(B == 1 ? opt.bound1_val() : opt.bound2_val());
+  }
+};
+
+/// No constraints, fills the unused places of a Fimcp_model
+struct No_block {
+  /// needs the class labels
+  static const bool uses_labels = false;
+  /// only frequency and linear side constraints (for -hybrid)
+  static const bool only_linear = true;
+  static void post_base(Block_home&, const Options_fimcp&) {}
+  static void post_setting(Block_home&, const Options_fimcp&) {}
+};
+
+/// covered: a transaction is covered iff it contains all items
+struct Coverage_block : public No_block {
+  /// with \a cclause as clauses, else as linear sums
+  static void post(Block_home& h, bool cclause) {
+    /** covered constraints **/
+    if (cclause) {
+      // Default! Clause is a bit faster and uses less memory
+      BoolVarArgs none(0);
+      for (int t=0; t!=h.nr_t; t++) {
+        // count row
+        int row_sum = h.nr_i;
+        for (int i=0; i!=h.nr_i; i++)
+          row_sum -= h.tdb[t][i];
+        BoolVarArgs row(row_sum);
+        // make row
+        for (int i=0; i!=h.nr_i; i++) {
+          if (1-h.tdb[t][i])
+            row[--row_sum] = h.items[i];
+        }
+        // coverage: the trans its complement has no supported items
+        // !row_compl[1] AND !row_compl[2] ...  <=> t_k
+        clause(h.home, BOT_AND, none, row, h.transactions[t]);
+      }
+    } else {
+      IntArgs row_(h.nr_i);
+      for (int t=0; t!=h.nr_t; t++) {
+        // make 1-row
+        for (int i=0; i!=h.nr_i; i++)
+          row_[i] = (1-h.tdb[t][i]);
+        // coverage: the trans its complement has no supported items
+        // sum((1-row(trans_t))*Items) = 0 <=> trans_t
+        linear(h.home, row_, h.items, IRT_EQ, 0, h.transactions[t]);
+      }
+    }
+  }
+  static void post_base(Block_home& h, const Options_fimcp& opt) {
+    post(h, opt.cclause());
+  }
+};
+
+/// closed: no item can be added without losing support
+struct Closed_block : public No_block {
+  static const bool only_linear = false;
+  static void post(Block_home& h) {
+    /** closed constraints **/
+    IntArgs col_(h.nr_t);
+    for (int i=0; i!=h.nr_i; i++) {
+      // make 1-col
+      for (int t=0; t!=h.nr_t; t++)
+        col_[t] = (1-h.tdb[t][i]);
+      // closed: the item its complement has no supported trans
+      // sum((1-col(item_i))*Trans) = 0 <=> item_i
+      linear(h.home, col_, h.transactions, IRT_EQ, 0, h.items[i]);
+    }
+  }
+  static void post_base(Block_home& h, const Options_fimcp&) {
+    post(h);
+  }
+};
+
+/// delta-closed: no item can be added without losing more than -delta
+struct Deltaclosed_block : public No_block {
+  static const bool only_linear = false;
+  static void post(Block_home& h, float delta) {
+    /** delta-closed constraints **/
+    int hdelta = (int)(delta*PRECISION);
+    IntArgs col_delta(h.nr_t);
+    for (int i=0; i!=h.nr_i; i++) {
+      // make col_delta: (1-col)*1000 - delta*1000 {precision with 3 numbers after comma}
+      for (int t=0; t!=h.nr_t; t++)
+        col_delta[t] = (h.counted(t) ? ((1-h.tdb[t][i])*PRECISION) - hdelta : 0);
+      // delta-closed: the item its complement has at most a few supported trans
+      // sum( (100*(1-col(item_i))-100*delta)*Trans ) =< 0 <=> item_i
+      linear(h.home, col_delta, h.transactions, IRT_LQ, 0, h.items[i]);
+    }
+  }
+  static void post_setting(Block_home& h, const Options_fimcp& opt) {
+    post(h, opt.delta());
+  }
+};
+
+/// frequency: support at least -freq
+struct Frequent_block : public No_block {
+  /// absolute support \a freq
+  static void post(Block_home& h, int freq) {
+    /** frequency constraints **/
+    IntArgs col(h.nr_t);
+    for (int i=0; i!=h.nr_i; i++) {
+      // make col
+      for (int t=0; t!=h.nr_t; t++)
+        col[t] = h.tdb[t][i]*h.counted(t);
+      // freq: the item is supported by sufficiently many trans
+      BoolVar aux(h.home, 0, 1); // auxiliary variable
+      // sum(col(item_i)*Trans) >= Freq <=> aux
+      linear(h.home, col, h.transactions, IRT_GQ, freq, aux);
+      // item_i => aux :: item_i =< aux
+      rel(h.home, h.items[i], IRT_LQ, aux);
+    }
+  }
+  static void post_setting(Block_home& h, const Options_fimcp& opt) {
+    post(h, opt.getFreq(h.nr_pos));
+  }
+};
+
+/// frequency+maximal: frequent, and no item can be added without
+/// becoming infrequent (replaces Frequent_block)
+struct Maximal_block : public No_block {
+  static const bool only_linear = false;
+  /// absolute support \a freq
+  static void post(Block_home& h, int freq) {
+    /** frequency+maximal constraints **/
+    IntArgs col(h.nr_t);
+    for (int i=0; i!=h.nr_i; i++) {
+      // make col
+      for (int t=0; t!=h.nr_t; t++)
+        col[t] = h.tdb[t][i]*h.counted(t);
+      // maximal: the item is supported by sufficiently many trans, and if so then the item itself must be supported
+      // sum(col(i_k)*Trans) >= Freq <=> i_k
+      linear(h.home, col, h.transactions, IRT_GQ, freq, h.items[i]);
+    }
+  }
+  static void post_setting(Block_home& h, const Options_fimcp& opt) {
+    post(h, opt.getFreq(h.nr_pos));
+  }
+};
+
+/// infrequency: at most -infreq negative transactions (labelled)
+struct Infrequent_block : public No_block {
+  static const bool uses_labels = true;
+  static const bool only_linear = false;
+  /// absolute negative support \a infreq_neg
+  static void post(Block_home& h, int infreq_neg) {
+    /** infrequency constraints, only on neg (no gain for reified) **/
+    IntArgs col_neg(h.nr_t);
+    // make col_neg
+    for (int t=0; t!=h.nr_t; t++)
+      col_neg[t] = (1-h.classes[t]);
+    // infreq: the item is supported by not more than a few trans
+    linear(h.home, col_neg, h.transactions, IRT_LQ, infreq_neg);
+  }
+  static void post_setting(Block_home& h, const Options_fimcp& opt) {
+    post(h, opt.getInfreq(h.nr_t-h.nr_pos));
+  }
+};
+
+/// emerging: the growth rate from neg to pos is at least -delta (labelled)
+struct Emerging_block : public No_block {
+  static const bool uses_labels = true;
+  static const bool only_linear = false;
+  static void post(Block_home& h, float delta) {
+    /** emerging constraints **/
+    // deltaPosNeg = PRECISION*delta*posTot/negTot (see below)
+    float deltaPosNeg = PRECISION*delta*h.nr_pos/(float)(h.nr_t-h.nr_pos);
+    IntArgs col_em(h.nr_t);
+    for (int i=0; i!=h.nr_i; i++) {
+      // make col_em: (pos/posTot)/(neg/negTot) > delta <=> pos - neg*delta*posTot/negTot > 0
+      for (int t=0; t!=h.nr_t; t++) {
+        if (h.classes[t] == 1) // pos*PRECISION
+          col_em[t] = h.tdb[t][i]*PRECISION;
+        else // (classes[t] == 0)  -neg*deltaPosNeg
+          col_em[t] = (int)(-h.tdb[t][i]*deltaPosNeg);
+      }
+      // emerging: support increases significantly from pos to neg
+      BoolVar aux(h.home, 0, 1); // auxiliary variable
+      // sum_emerging > 0 <=> aux
+      linear(h.home, col_em, h.transactions, IRT_GR, 0, aux);
+      // item_i => aux :: item_i =< aux
+      rel(h.home, h.items[i], IRT_LQ, aux);
+    }
+  }
+  static void post_setting(Block_home& h, const Options_fimcp& opt) {
+    post(h, opt.delta());
+  }
+};
+
+/// size: the nr of items within -bound<B>
+template<int B = 1>
+struct Size_block : public No_block {
+  /// nr of items \a r \a n
+  static void post(Block_home& h, IntRelType r, int n) {
+    /** size constraint **/
+    // size: the size of the itemset is within the bound
+    // count(items) >=< X  [>=<:{>=,=<,=,!=,<,>}, X:integer]
+    linear(h.home, h.items, r, n);
+    h.side.push_back(HybridSide(vector<int>(h.nr_i, 1), r, n));
+  }
+  static void post_setting(Block_home& h, const Options_fimcp& opt) {
+    post(h, Bound<B>::op(opt), Bound<B>::val(opt));
+  }
+};
+
+/// The cost of every item, from -attrfile
+inline vector<int> read_cost(const Options_fimcp& opt) {
+  // attributes: get cost
+  Reader_SSV<int> data;
+  data.read(opt.attrfile());
+  return data.data[0];
+}
+
+/// cost: the sum of the costs of the items within -bound<B>
+template<int B = 1>
+struct Cost_block : public No_block {
+  /// sum of the \a cost of the items \a r \a n
+  static void post(Block_home& h, const vector<int>& cost, IntRelType r, int n) {
+    /** cost constraint **/
+    // make row_cost
+    IntArgs row_cost(h.nr_i);
+    for (int i=0; i!=h.nr_i; i++)
+      row_cost[i] = cost[i];
+    // cost: the cost of the itemset is within the bound
+    // sum(cost) >=< X  [>=<:{>=,=<,=,!=,<,>}, X:integer]
+    linear(h.home, row_cost, h.items, r, n);
+    h.side.push_back(HybridSide(cost, r, n));
+  }
+  static void post_setting(Block_home& h, const Options_fimcp& opt) {
+    post(h, read_cost(opt), Bound<B>::op(opt), Bound<B>::val(opt));
+  }
+};
+
+/// average cost: the average cost of the items within -bound<B>
+template<int B = 1>
+struct Avgcost_block : public No_block {
+  /// average \a cost of the items \a r \a n
+  static void post(Block_home& h, const vector<int>& cost, IntRelType r, int n) {
+    /** average cost constraint **/
+    // make row_avgcost: sum(cost*col)/sum(col) > 10 <=> sum((cost-10)*col) > 0
+    vector<int> coef(h.nr_i);
+    IntArgs row_avgcost(h.nr_i);
+    for (int i=0; i!=h.nr_i; i++)
+      row_avgcost[i] = coef[i] = cost[i] - n;
+    // average cost: the average cost of the itemset is within the bound
+    // sum((cost-X)*col*itemz) >=< 0  [>=<:{>=,=<,=,!=,<,>}, X:integer]
+    linear(h.home, row_avgcost, h.items, r, 0);
+    h.side.push_back(HybridSide(coef, r, 0));
+  }
+  static void post_setting(Block_home& h, const Options_fimcp& opt) {
+    post(h, read_cost(opt), Bound<B>::op(opt), Bound<B>::val(opt));
+  }
+};
+
+/**
+ * \brief A model: the blocks \a B1 .. \a B5, posted in that order
+ *
+ * The coverage block is always posted first.
+ */
+template<class B1, class B2 = No_block, class B3 = No_block,
+         class B4 = No_block, class B5 = No_block>
+struct Fimcp_model {
+  static const bool uses_labels = B1::uses_labels || B2::uses_labels ||
+    B3::uses_labels || B4::uses_labels || B5::uses_labels;
+  static const bool only_linear = B1::only_linear && B2::only_linear &&
+    B3::only_linear && B4::only_linear && B5::only_linear;
+  static void post_base(Block_home& h, const Options_fimcp& opt) {
+    Coverage_block::post_base(h, opt);
+    B1::post_base(h, opt);
+    B2::post_base(h, opt);
+    B3::post_base(h, opt);
+    B4::post_base(h, opt);
+    B5::post_base(h, opt);
+  }
+  static void post_setting(Block_home& h, const Options_fimcp& opt) {
+    B1::post_setting(h, opt);
+    B2::post_setting(h, opt);
+    B3::post_setting(h, opt);
+    B4::post_setting(h, opt);
+    B5::post_setting(h, opt);
+  }
+};
+
+/**
+ * \brief The blocks of a -model spec
+ *
+ * A spec is a '+' separated list of: standard, closed, deltaclosed,
+ * maximal, discriminating, emerging, size, cost, avgcost. Frequency is
+ * always included (maximal implies it). The first of size, cost and
+ * avgcost uses -bound1, the second -bound2.
+ *
+ * Combinations of the fimcp_* binaries use their compiled Fimcp_model,
+ * others (and Block_profile) call the blocks one by one.
+ *
+ */
+class Fimcp_blocks {
+public:
+  /// A post_base() or post_setting() of a block
+  typedef void (*Post)(Block_home&, const Options_fimcp&);
+protected:
+  /// the blocks, in canonical order, eg "closed+cost"
+  string _name;
+  /// uses the class labels
+  bool _labels;
+  /// has maximal (not for -store)
+  bool _maximal;
+  /// only frequency and linear side constraints (for -hybrid)
+  bool _linear;
+  /// reads -attrfile
+  bool _attributes;
+  /// a compiled Fimcp_model, or NULL
+  Post base;
+  Post setting;
+  /// the blocks one by one, in posting order (coverage first)
+  vector<string> names;
+  vector<Post> bases;
+  vector<Post> settings;
+  /// Append block \a B, named \a n
+  template<class B>
+  void add(const char* n) {
+    names.push_back(n);
+    bases.push_back(&B::post_base);
+    settings.push_back(&B::post_setting);
+  }
+public:
+  /// The blocks of \a spec, exits on an unknown block
+  Fimcp_blocks(const char* spec);
+  /// Is \a spec a valid combination? if not, the reason is in \a error
+  static bool valid(const char* spec, string& error);
+  /// The spec of the binary of \a opt: its name (fimcp_closed+cost), or -model
+  static string spec(const Options_fimcp& opt);
+
+  /// Canonical name of the combination
+  const char* name(void) const { return _name.c_str(); }
+  /// Composed at compile time?
+  bool compiled(void) const { return base != NULL; }
+  bool labels(void) const { return _labels; }
+  bool maximal(void) const { return _maximal; }
+  bool linear(void) const { return _linear; }
+  bool attributes(void) const { return _attributes; }
+
+  /// Post the blocks that do not depend on the thresholds
+  void post_base(Block_home& h, const Options_fimcp& opt) const;
+  /// Post the threshold blocks
+  void post_setting(Block_home& h, const Options_fimcp& opt) const;
+
+  /// Nr of blocks, coverage and frequency included
+  int size(void) const { return names.size(); }
+  /// Name of block \a k
+  const char* block(int k) const { return names[k].c_str(); }
+  /// Post block \a k, both parts (see Block_profile)
+  void post_block(int k, Block_home& h, const Options_fimcp& opt) const {
+    bases[k](h, opt);
+    settings[k](h, opt);
+  }
+};
+
+/// The combinations of the fimcp_* binaries, compiled in fimcp_blocks.cpp
+typedef Fimcp_model<Frequent_block> Standard_model;
+typedef Fimcp_model<Closed_block, Frequent_block> Closed_model;
+typedef Fimcp_model<Maximal_block> Maximal_model;
+typedef Fimcp_model<Deltaclosed_block, Frequent_block> Deltaclosed_model;
+typedef Fimcp_model<Frequent_block, Infrequent_block> Discriminating_model;
+typedef Fimcp_model<Deltaclosed_block, Frequent_block, Infrequent_block> Discriminating_deltaclosed_model;
+typedef Fimcp_model<Frequent_block, Emerging_block> Emerging_model;
+typedef Fimcp_model<Frequent_block, Size_block<1> > Size_model;
+typedef Fimcp_model<Frequent_block, Cost_block<1> > Cost_model;
+typedef Fimcp_model<Frequent_block, Avgcost_block<1> > Avgcost_model;
+typedef Fimcp_model<Closed_block, Frequent_block, Cost_block<1> > Closed_cost_model;
+
+extern template struct Fimcp_model<Frequent_block>;
+extern template struct Fimcp_model<Closed_block, Frequent_block>;
+extern template struct Fimcp_model<Maximal_block>;
+extern template struct Fimcp_model<Deltaclosed_block, Frequent_block>;
+extern template struct Fimcp_model<Frequent_block, Infrequent_block>;
+extern template struct Fimcp_model<Deltaclosed_block, Frequent_block, Infrequent_block>;
+extern template struct Fimcp_model<Frequent_block, Emerging_block>;
+extern template struct Fimcp_model<Frequent_block, Size_block<1> >;
+extern template struct Fimcp_model<Frequent_block, Cost_block<1> >;
+extern template struct Fimcp_model<Frequent_block, Avgcost_block<1> >;
+extern template struct Fimcp_model<Closed_block, Frequent_block, Cost_block<1> >;
+
+/// The model of a fimcp_* binary, see Fimcp_basic::post_model
+template<class Model>
+void Fimcp_basic::post_model(const Options_fimcp& opt) {
+  const vector< vector<bool> > tdb = model_construction(opt, Model::uses_labels);
+  Block_home home(*this, items, transactions, tdb, classes);
+
+  // shared by all settings of a batch
+  if (posting_base())
+    Model::post_base(home, opt);
+
+  if (!posting_setting())
+    return; // the base of a batch, see Batch
+
+  Model::post_setting(home, opt);
+  post_search(opt, home, Model::only_linear);
+}
+
+#endif
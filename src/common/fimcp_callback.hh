@@ -0,0 +1,58 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_CALLBACK_HH__
+#define __FIMCP_COMMON_CALLBACK_HH__
+
+#include <functional>
+#include <vector>
+using namespace std;
+
+#include "tidset.hh"
+
+/// A solution, as handed to a Fimcp_callback (valid during the call only)
+struct Fimcp_solution {
+  /// the item ids, increasing
+  const vector<int>* items;
+  /// support: nr of transactions, of positive ones for labelled models
+  int support;
+  /// nr of negative transactions for labelled models, else 0
+  int neg;
+  /// the transactions as tidset (see tidset.hh) if asked for, else NULL
+  const word_t* tids;
+};
+
+/// Called for every solution, the search stops when it returns false
+typedef std::function<bool(const Fimcp_solution&)> Fimcp_callback;
+
+#endif
@@ -0,0 +1,224 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_ECLAT__
+#define __FIMCP_COMMON_ECLAT__
+
+#include "fimcp_eclat.hh"
+
+#include <algorithm>
+#include <iterator>
+
+/// Engine for \a d with minimal support \a f, calling \a cb
+Fimcp_eclat::Fimcp_eclat(const Dataset& d, int f, const Fimcp_callback& cb, bool tids) :
+    Fimcp_native(d, f, cb, tids),
+    nr_words(tidset_words(d.nr_t)),
+    vertical(tids ? (int)VERT_TIDSET : (int)VERT_AUTO),
+    budget(0), in_use(0), checkpoint_seen(0) {
+}
+
+/// Report the current itemset
+void Fimcp_eclat::report_prefix(const word_t* set, int supp) {
+    sorted = prefix;
+    sort(sorted.begin(), sorted.end());
+    tids.clear();
+    if (need_tids())
+        tidset_list(set, nr_words, tids);
+    report(sorted, supp, tids);
+}
+
+/// Should the children of candidate \a k use diffsets?
+bool Fimcp_eclat::dense(const Level& cur, int k, int n) const {
+    if (vertical != VERT_AUTO)
+        return (vertical == VERT_DIFFSET);
+    // a diffset of the children has at most as many tids as its candidate
+    // lost w.r.t. the prefix: cheaper than a tidset if shorter than its words
+    double lost = 0;
+    for (int j=k+1; j<n; j++)
+        lost += cur.supp - cur.supps[j];
+    // near the memory budget: whichever takes fewer bytes
+    if (budget != 0 && in_use > 0.75*budget)
+        return (lost*sizeof(int) < (double)(n-k-1)*nr_words*sizeof(word_t));
+    return (lost < (double)(n-k-1)*nr_words);
+}
+
+/// Extend the current itemset with the \a n candidates at \a depth
+void Fimcp_eclat::expand(int depth, int n, bool resumed) {
+    if (depth > depth_max)
+        depth_max = depth;
+    Level& cur = levels[depth];
+    Level& next = levels[depth+1];
+    // a resumed checkpoint continues at its candidate
+    const vector<int>& resume = Checkpoint::path();
+    int first = (resumed ? resume[depth] : 0);
+    if (first >= n) {
+        fprintf(stderr, "\tError: the checkpoint does not match the search of this dataset !\n");
+        exit(1);
+    }
+    for (int k=first; k!=n; k++) {
+        if (stopped())
+            return;
+        // above the node of the checkpoint: reported before
+        bool above = (resumed && k == first && depth+1 != (int)resume.size());
+        const word_t* set_k = (cur.diff ? NULL : &cur.sets[k*nr_words]);
+        prefix.push_back(cur.items[k]);
+        positions.push_back(k);
+        if (!above && Checkpoint::enabled() && Checkpoint::due(checkpoint_seen))
+            Checkpoint::save(positions, sols, writer);
+        nodes++;
+        progress(depth, k, n);
+        if (!above)
+            report_prefix(set_k, cur.supps[k]);
+
+        // frequent extensions with the later candidates
+        next.supp = cur.supps[k];
+        next.diff = (cur.diff || dense(cur, k, n));
+        next.items.clear();
+        next.supps.clear();
+        int m = 0;
+        if (!next.diff) {
+            // t(PXY) = t(PX) & t(PY)
+            if (next.sets.size() < (size_t)(n-k-1)*nr_words) {
+                next.sets.resize((n-k-1)*nr_words);
+                in_use = memory();
+            }
+            for (int j=k+1; j!=n; j++) {
+                int supp = tidset_and(&next.sets[m*nr_words], set_k,
+                                      &cur.sets[j*nr_words], nr_words);
+                if (supp >= freq) {
+                    next.items.push_back(cur.items[j]);
+                    next.supps.push_back(supp);
+                    m++;
+                }
+            }
+        } else {
+            next.dstart.assign(1, 0);
+            next.dtids.clear();
+            for (int j=k+1; j!=n; j++) {
+                int lost;
+                if (!cur.diff) {
+                    // d(PXY) = t(PX) - t(PY)
+                    lost = tidset_andnot_list(set_k, &cur.sets[j*nr_words], nr_words, next.dtids);
+                } else {
+                    // d(PXY) = d(PY) - d(PX)
+                    int len = next.dtids.size();
+                    set_difference(cur.dtids.begin()+cur.dstart[j], cur.dtids.begin()+cur.dstart[j+1],
+                                   cur.dtids.begin()+cur.dstart[k], cur.dtids.begin()+cur.dstart[k+1],
+                                   back_inserter(next.dtids));
+                    lost = next.dtids.size() - len;
+                }
+                int supp = cur.supps[k] - lost;
+                if (supp >= freq) {
+                    next.items.push_back(cur.items[j]);
+                    next.supps.push_back(supp);
+                    next.dstart.push_back(next.dtids.size());
+                    m++;
+                } else {
+                    next.dtids.resize(next.dstart.back());
+                }
+            }
+        }
+        if (m != 0)
+            expand(depth+1, m, above);
+        else if (above) {
+            fprintf(stderr, "\tError: the checkpoint does not match the search of this dataset !\n");
+            exit(1);
+        }
+        prefix.pop_back();
+        positions.pop_back();
+    }
+}
+
+/// Enumerate all solutions
+void Fimcp_eclat::run(void) {
+    const int nr_t = data.nr_t;
+    const int nr_i = data.nr_i;
+
+    // frequent items, by increasing support
+    vector<int> supp(nr_i, 0);
+    for (int t=0; t!=nr_t; t++) {
+        for (int i=0; i!=nr_i; i++)
+            supp[i] += data.tdb[t][i];
+    }
+    vector< pair<int,int> > freq_items;
+    for (int i=0; i!=nr_i; i++) {
+        if (supp[i] >= freq)
+            freq_items.push_back(make_pair(supp[i], i));
+    }
+    sort(freq_items.begin(), freq_items.end());
+    int n = freq_items.size();
+
+    // their tidsets are the candidates at depth 0
+    levels.resize(n+1);
+    Level& root = levels[0];
+    root.supp = nr_t;
+    root.diff = false;
+    vector<int> pos(nr_i, -1);
+    for (int k=0; k!=n; k++) {
+        root.items.push_back(freq_items[k].second);
+        root.supps.push_back(freq_items[k].first);
+        pos[freq_items[k].second] = k;
+    }
+    root.sets.assign(n*nr_words, 0);
+    for (int t=0; t!=nr_t; t++) {
+        for (int i=0; i!=nr_i; i++) {
+            if (data.tdb[t][i] && pos[i] != -1)
+                root.sets[pos[i]*nr_words + t/WORD_BITS] |= (word_t)1 << (t%WORD_BITS);
+        }
+    }
+
+    // the empty itemset covers all transactions
+    vector<word_t> all(nr_words, ~(word_t)0);
+    if (nr_t % WORD_BITS != 0)
+        all[nr_words-1] = ((word_t)1 << (nr_t % WORD_BITS)) - 1;
+    nodes++;
+    if (Checkpoint::resuming())
+        sols = Checkpoint::solutions();
+    else
+        report_prefix(all.data(), nr_t);
+    in_use = memory();
+    if (n != 0)
+        expand(0, n, Checkpoint::resuming());
+}
+
+/// Memory in use by the engine, in bytes
+size_t Fimcp_eclat::memory(void) const {
+    size_t mem = 0;
+    for (unsigned int d=0; d!=levels.size(); d++) {
+        mem += levels[d].sets.capacity()*sizeof(word_t);
+        mem += (levels[d].dstart.capacity() + levels[d].dtids.capacity())*sizeof(int);
+    }
+    return mem;
+}
+
+#endif
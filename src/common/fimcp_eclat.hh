@@ -0,0 +1,127 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_ECLAT_HH__
+#define __FIMCP_COMMON_ECLAT_HH__
+
+#include "fimcp_native.hh"
+#include "tidset.hh"
+
+/**
+ * \brief Native Eclat engine for standard frequent itemset mining
+ *
+ * Depth-first search over the frequent items (by increasing support),
+ * the tidset of every itemset is the intersection of the tidset of its
+ * prefix and that of the last item. Only coverage and minimal frequency,
+ * the same solutions as fimcp_standard with the same output.
+ *
+ * On dense data the tidsets stay nearly full deep in the search. There
+ * the children of a node use diffsets instead (Zaki and Gouda, dEclat):
+ * the sorted list of the transactions the child loses w.r.t. its parent,
+ * d(PXY) = t(PX) - t(PY) and below that d(PXY) = d(PY) - d(PX), with
+ * supp(PXY) = supp(PX) - |d(PXY)|. A subtree stays in diffsets once it
+ * switched. With -vertical auto, a node switches when its candidates lose
+ * on average fewer transactions w.r.t. its prefix than a tidset has words.
+ * Full output needs the tidsets, so then it never switches.
+ *
+ * With -membudget, once the tidsets use 3/4 of the budget, a node
+ * switches whenever the diffsets of its children take fewer bytes.
+ *
+ * A checkpoint (see Checkpoint) records the candidate nr of every item of
+ * the prefix, in the order of the candidates at its depth.
+ *
+ */
+class Fimcp_eclat : public Fimcp_native {
+protected:
+  /// words per tidset
+  int nr_words;
+  /// tidsets, diffsets or switch automatically (VerticalType)
+  int vertical;
+  /// bytes left of -membudget (0: no budget), bytes of the levels
+  double budget;
+  size_t in_use;
+  /// candidates at every depth: items, their support and tidsets or diffsets
+  struct Level {
+    /// support of the prefix of the candidates
+    int supp;
+    vector<int> items;
+    vector<int> supps;
+    /// diffsets instead of tidsets?
+    bool diff;
+    /// tidsets: nr_words per candidate
+    vector<word_t> sets;
+    /// diffsets: of candidate k, dtids[dstart[k]] .. dtids[dstart[k+1]-1]
+    vector<int> dstart;
+    vector<int> dtids;
+  };
+  vector<Level> levels;
+  /// items of the current itemset, and their candidate nr at every depth
+  vector<int> prefix;
+  vector<int> positions;
+  unsigned int checkpoint_seen;
+  /// scratch space for report()
+  vector<int> sorted, tids;
+
+  /// Report the current itemset, with tidset \a set and support \a supp
+  void report_prefix(const word_t* set, int supp);
+  /// Should the children of candidate \a k (of \a n) of \a cur use diffsets?
+  bool dense(const Level& cur, int k, int n) const;
+  /// Extend the current itemset with the \a n candidates at \a depth,
+  /// \a resumed: the prefix is on the path of the resumed checkpoint
+  void expand(int depth, int n, bool resumed);
+public:
+  /// Engine for \a data with the settings of \a opt
+  Fimcp_eclat(const Options_fimcp& opt, const Dataset& data);
+  /// Engine for \a data with minimal support \a freq, calling \a cb (library)
+  Fimcp_eclat(const Dataset& data, int freq, const Fimcp_callback& cb, bool tids);
+  /// Enumerate all solutions
+  virtual void run(void);
+  /// Memory in use by the engine, in bytes
+  virtual size_t memory(void) const;
+};
+
+inline
+Fimcp_eclat::Fimcp_eclat(const Options_fimcp& opt, const Dataset& d) :
+    Fimcp_native(opt, d),
+    nr_words(tidset_words(d.nr_t)),
+    vertical(need_tids() ? (int)VERT_TIDSET : opt.vertical()),
+    budget(0), in_use(0), checkpoint_seen(0) {
+    if (opt.membudget() != 0) {
+        // what is left once the data is read
+        budget = opt.membudget()*1048576.0 - Phases::rss()*1024.0;
+        if (budget <= 0)
+            budget = 1;
+    }
+}
+
+#endif
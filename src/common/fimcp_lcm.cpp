@@ -0,0 +1,277 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_LCM__
+#define __FIMCP_COMMON_LCM__
+
+#include "fimcp_lcm.hh"
+
+#include <algorithm>
+
+/// Lexicographic order on the transactions of a database
+struct Fimcp_lcm_less {
+    const vector<int>& start;
+    const vector<int>& items;
+    Fimcp_lcm_less(const vector<int>& s, const vector<int>& i) : start(s), items(i) {}
+    bool operator()(int a, int b) const {
+        return lexicographical_compare(items.begin()+start[a], items.begin()+start[a+1],
+                                       items.begin()+start[b], items.begin()+start[b+1]);
+    }
+};
+
+/// Engine for \a d with minimal support \a f, calling \a cb
+Fimcp_lcm::Fimcp_lcm(const Dataset& d, int f, const Fimcp_callback& cb, bool tids) :
+    Fimcp_native(d, f, cb, tids),
+    nr_f(0),
+    merge(!tids) {
+}
+
+/// Report the current closed itemset
+void Fimcp_lcm::report_closed(const Db& db, const vector<int>& occ, int supp) {
+    sorted = closed;
+    sort(sorted.begin(), sorted.end());
+    tids.clear();
+    if (need_tids()) {
+        for (unsigned int k=0; k!=occ.size(); k++)
+            tids.push_back(db.tid[occ[k]]);
+        sort(tids.begin(), tids.end());
+    }
+    report(sorted, supp, tids);
+}
+
+/// Reduce \a unmerged into \a db
+void Fimcp_lcm::reduce(Db& db) {
+    if (!merge) {
+        db.start.swap(unmerged.start);
+        db.items.swap(unmerged.items);
+        db.weight.swap(unmerged.weight);
+        db.tid.swap(unmerged.tid);
+        return;
+    }
+
+    // identical transactions are adjacent once sorted
+    int m = unmerged.size();
+    order.resize(m);
+    for (int k=0; k!=m; k++)
+        order[k] = k;
+    sort(order.begin(), order.end(), Fimcp_lcm_less(unmerged.start, unmerged.items));
+
+    db.clear();
+    const vector<int>& start = unmerged.start;
+    const vector<int>& items = unmerged.items;
+    for (int k=0; k!=m; k++) {
+        int t = order[k];
+        if (k != 0) {
+            int prev = order[k-1];
+            if (start[t+1]-start[t] == start[prev+1]-start[prev] &&
+                equal(items.begin()+start[t], items.begin()+start[t+1], items.begin()+start[prev])) {
+                db.weight.back() += unmerged.weight[t];
+                continue;
+            }
+        }
+        db.items.insert(db.items.end(), items.begin()+start[t], items.begin()+start[t+1]);
+        db.start.push_back(db.items.size());
+        db.weight.push_back(unmerged.weight[t]);
+    }
+}
+
+/// Extend the current closed itemset with the items after \a core
+void Fimcp_lcm::expand(int depth, int core) {
+    if (depth > depth_max)
+        depth_max = depth;
+    const Db& db = dbs[depth];
+    if (occs[depth].size() == 0) {
+        occs[depth].resize(nr_f);
+        supps[depth].assign(nr_f, 0);
+    }
+    vector< vector<int> >& occ = occs[depth];
+    vector<int>& supp = supps[depth];
+
+    // occurrence delivery: the occurrences of all extensions in one pass
+    for (int k=0; k!=db.size(); k++) {
+        for (int p=db.start[k+1]-1; p>=db.start[k] && db.items[p] > core; p--) {
+            occ[db.items[p]].push_back(k);
+            supp[db.items[p]] += db.weight[k];
+        }
+    }
+
+    for (int e=core+1; e<nr_f; e++) {
+        const vector<int>& occ_e = occ[e];
+        if (supp[e] >= freq && !stopped()) {
+            nodes++;
+            progress(depth, e-core-1, nr_f-core-1);
+            // frequency of every item in the occurrences of e
+            for (unsigned int k=0; k!=occ_e.size(); k++) {
+                int t = occ_e[k];
+                for (int p=db.start[t]; p!=db.start[t+1]; p++)
+                    cnt[db.items[p]] += db.weight[t];
+            }
+
+            // closure: the items in every occurrence, prefix-preserving if none is before e
+            unsigned int nr_closed = closed.size();
+            bool ppc = true;
+            for (int p=db.start[occ_e[0]]; p!=db.start[occ_e[0]+1]; p++) {
+                int j = db.items[p];
+                if (cnt[j] == supp[e]) {
+                    if (j < e) {
+                        ppc = false;
+                        break;
+                    }
+                    closed.push_back(orig[j]);
+                }
+            }
+
+            if (ppc)
+                report_closed(db, occ_e, supp[e]);
+
+            // conditional database: without the closure and the infrequent items,
+            // only transactions that can still be extended (have an item after e)
+            bool deeper = false;
+            if (ppc && !stopped()) {
+                unmerged.clear();
+                for (unsigned int k=0; k!=occ_e.size(); k++) {
+                    int t = occ_e[k];
+                    int len = unmerged.items.size();
+                    for (int p=db.start[t]; p!=db.start[t+1]; p++) {
+                        int j = db.items[p];
+                        if (cnt[j] >= freq && cnt[j] != supp[e])
+                            unmerged.items.push_back(j);
+                    }
+                    if ((int)unmerged.items.size() == len || unmerged.items.back() < e) {
+                        unmerged.items.resize(len);
+                    } else {
+                        unmerged.start.push_back(unmerged.items.size());
+                        unmerged.weight.push_back(db.weight[t]);
+                        if (!merge)
+                            unmerged.tid.push_back(db.tid[t]);
+                    }
+                }
+                deeper = (unmerged.size() != 0);
+            }
+
+            // the counters are shared by all depths: reset before going deeper
+            for (unsigned int k=0; k!=occ_e.size(); k++) {
+                int t = occ_e[k];
+                for (int p=db.start[t]; p!=db.start[t+1]; p++)
+                    cnt[db.items[p]] = 0;
+            }
+            if (deeper) {
+                reduce(dbs[depth+1]);
+                expand(depth+1, e);
+            }
+            closed.resize(nr_closed);
+        }
+        occ[e].clear();
+        supp[e] = 0;
+    }
+}
+
+/// Enumerate all solutions
+void Fimcp_lcm::run(void) {
+    const int nr_t = data.nr_t;
+    const int nr_i = data.nr_i;
+
+    vector<int> supp(nr_i, 0);
+    for (int t=0; t!=nr_t; t++) {
+        for (int i=0; i!=nr_i; i++)
+            supp[i] += data.tdb[t][i];
+    }
+
+    // the closure of the empty itemset: the items in every transaction
+    // the other frequent items, renamed by increasing support
+    vector< pair<int,int> > freq_items;
+    for (int i=0; i!=nr_i; i++) {
+        if (supp[i] == nr_t)
+            closed.push_back(i);
+        else if (supp[i] >= freq)
+            freq_items.push_back(make_pair(supp[i], i));
+    }
+    sort(freq_items.begin(), freq_items.end());
+    nr_f = freq_items.size();
+    vector<int> name(nr_i, -1);
+    for (int k=0; k!=nr_f; k++) {
+        orig.push_back(freq_items[k].second);
+        name[freq_items[k].second] = k;
+    }
+
+    nodes++;
+    if (closed.size() != 0 && nr_t < freq)
+        return; // its items are not frequent
+    vector<int> all;
+    for (int t=0; t!=nr_t && need_tids(); t++)
+        all.push_back(t);
+    sorted = closed;
+    report(sorted, nr_t, all);
+    if (nr_f == 0 || stopped())
+        return;
+
+    // initial database, on the renamed items
+    dbs.resize(nr_f+1);
+    occs.resize(nr_f+1);
+    supps.resize(nr_f+1);
+    cnt.assign(nr_f, 0);
+    unmerged.clear();
+    for (int t=0; t!=nr_t; t++) {
+        int len = unmerged.items.size();
+        for (int i=0; i!=nr_i; i++) {
+            if (data.tdb[t][i] && name[i] != -1)
+                unmerged.items.push_back(name[i]);
+        }
+        if ((int)unmerged.items.size() != len) {
+            sort(unmerged.items.begin()+len, unmerged.items.end());
+            unmerged.start.push_back(unmerged.items.size());
+            unmerged.weight.push_back(1);
+            if (!merge)
+                unmerged.tid.push_back(t);
+        }
+    }
+    reduce(dbs[0]);
+    expand(0, -1);
+}
+
+/// Memory in use by the engine, in bytes
+size_t Fimcp_lcm::memory(void) const {
+    size_t mem = 0;
+    for (unsigned int d=0; d!=dbs.size(); d++) {
+        const Db& db = dbs[d];
+        mem += (db.start.capacity() + db.items.capacity() +
+                db.weight.capacity() + db.tid.capacity())*sizeof(int);
+    }
+    for (unsigned int d=0; d!=occs.size(); d++) {
+        for (unsigned int e=0; e!=occs[d].size(); e++)
+            mem += occs[d][e].capacity()*sizeof(int);
+    }
+    return mem;
+}
+
+#endif
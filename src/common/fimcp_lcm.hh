@@ -0,0 +1,114 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_LCM_HH__
+#define __FIMCP_COMMON_LCM_HH__
+
+#include "fimcp_native.hh"
+
+/**
+ * \brief Native LCM-style engine for closed frequent itemset mining
+ *
+ * Prefix-preserving closure extension (Uno et al., LCM ver. 2): every
+ * closed itemset is extended with the frequent items e after its core
+ * item, the extension is kept only if its closure adds no item before e.
+ *
+ * The supports of all extensions are counted at once by occurrence
+ * delivery over a conditional database. That database is reduced at
+ * every step: items of the closure and infrequent items are removed and
+ * identical transactions are merged into one weighted transaction
+ * (not with full output, where every transaction keeps its id).
+ *
+ * The same solutions as fimcp_closed with the same output.
+ *
+ */
+class Fimcp_lcm : public Fimcp_native {
+protected:
+  /// conditional database of weighted transactions, items ascending
+  struct Db {
+    /// transaction k is items[start[k]] .. items[start[k+1]-1]
+    vector<int> start;
+    vector<int> items;
+    vector<int> weight;
+    /// original transaction id (full output only)
+    vector<int> tid;
+    int size(void) const { return weight.size(); }
+    void clear(void) { start.assign(1, 0); items.clear(); weight.clear(); tid.clear(); }
+  };
+  /// conditional database at every depth
+  vector<Db> dbs;
+  /// occurrences (transactions of the database) and support of every item, at every depth
+  vector< vector< vector<int> > > occs;
+  vector< vector<int> > supps;
+  /// frequency counter of every item in the current occurrences (kept at 0)
+  vector<int> cnt;
+  /// unmerged database and sort order, scratch space for reduce()
+  Db unmerged;
+  vector<int> order;
+
+  /// nr of frequent items, renamed 0..nr_f-1 by increasing support
+  int nr_f;
+  /// original item of every renamed item
+  vector<int> orig;
+  /// merge identical transactions?
+  bool merge;
+  /// (renamed) items of the current closed itemset
+  vector<int> closed;
+  /// scratch space for report()
+  vector<int> sorted, tids;
+
+  /// Report the current closed itemset, occurring in transactions \a occ of \a db
+  void report_closed(const Db& db, const vector<int>& occ, int supp);
+  /// Reduce \a unmerged into \a db: sort and merge identical transactions
+  void reduce(Db& db);
+  /// Extend the current closed itemset (conditional database at \a depth) with items after \a core
+  void expand(int depth, int core);
+public:
+  /// Engine for \a data with the settings of \a opt
+  Fimcp_lcm(const Options_fimcp& opt, const Dataset& data);
+  /// Engine for \a data with minimal support \a freq, calling \a cb (library)
+  Fimcp_lcm(const Dataset& data, int freq, const Fimcp_callback& cb, bool tids);
+  /// Enumerate all solutions
+  virtual void run(void);
+  /// Memory in use by the engine, in bytes
+  virtual size_t memory(void) const;
+};
+
+inline
+Fimcp_lcm::Fimcp_lcm(const Options_fimcp& opt, const Dataset& d) :
+    Fimcp_native(opt, d),
+    nr_f(0),
+    merge(!need_tids()) {
+}
+
+#endif
@@ -0,0 +1,100 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_NATIVE__
+#define __FIMCP_COMMON_NATIVE__
+
+#include "fimcp_native.hh"
+
+/// Engine for \a d with minimal support \a f, calling \a cb for every solution
+Fimcp_native::Fimcp_native(const Dataset& d, int f, const Fimcp_callback& cb, bool tids) :
+    data(d),
+    freq(f),
+    print_itemsets(PRINT_NONE),
+    writer(NULL),
+    max_sols(0),
+    below(0),
+    callback(cb),
+    tids_needed(tids),
+    halted(false),
+    nodes(0), sols(0), depth_max(0),
+    progress_seen(0), progress_nodes(0) {
+}
+
+/// Publish the progress at \a depth
+void Fimcp_native::progress_sample(int depth) {
+    // the candidates before k are done; candidate k extends with the
+    // n-k-1 after it, its subtree is taken to be proportional to n-k
+    double done = 0, share = 1;
+    for (int d=0; d<=depth; d++) {
+        double k = progress_path[d].first, n = progress_path[d].second;
+        double total = n*(n+1)/2;
+        done += share * (k*n - k*(k-1)/2) / total;
+        share *= (n-k) / total;
+    }
+    Progress::sample(nodes - progress_nodes, depth, done);
+    progress_nodes = nodes;
+}
+
+/// Report itemset \a items (sorted) with support \a supp
+void Fimcp_native::report(const vector<int>& items, int supp, const vector<int>& tids) {
+    if (below != 0 && supp >= below)
+        return; // in the result store already
+    sols++;
+    Progress::solution();
+    if (callback) {
+        Fimcp_solution sol = { &items, supp, 0, NULL };
+        if (tids_needed) {
+            bitmap.assign(tidset_words(data.nr_t), 0);
+            for (unsigned int k=0; k!=tids.size(); k++)
+                bitmap[tids[k]/WORD_BITS] |= (word_t)1 << (tids[k]%WORD_BITS);
+            sol.tids = &bitmap[0];
+        }
+        halted = !callback(sol);
+    } else if (print_itemsets != PRINT_NONE) {
+        Phases::Timer timer(Phases::PRINT);
+        writer->put_solution(print_itemsets, items, false, supp, 0, tids, data.nr_t);
+    }
+}
+
+/// Print the search statistics of engine \a name
+void Fimcp_native::statistics(const char* name, double runtime) const {
+    fprintf(stdout, "\nSummary (%s)\n", name);
+    fprintf(stdout, "\truntime:      %.3f ms\n", runtime);
+    fprintf(stdout, "\tsolutions:    %lu\n", sols);
+    fprintf(stdout, "\tnodes:        %lu\n", nodes);
+    fprintf(stdout, "\tpeak depth:   %i\n", depth_max);
+    fprintf(stdout, "\tpeak memory:  %lu KB\n", (unsigned long)(memory()+1023)/1024);
+}
+
+#endif
@@ -0,0 +1,189 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_NATIVE_HH__
+#define __FIMCP_COMMON_NATIVE_HH__
+
+#include "fimcp_basic.hh"
+#include "fimcp_callback.hh"
+#include "phases.hh"
+#include "progress.hh"
+#include "checkpoint.hh"
+
+/**
+ * \brief Base class of the native (non-CP) engines
+ *
+ * Takes the dataset, minimal frequency and output settings from the
+ * same options as the CP models, and prints its solutions with the same
+ * SolutionWriter, so that the output of an engine is identical to that
+ * of the corresponding model (up to the order of the solutions).
+ *
+ * An engine implements run(), calls report() for every solution and
+ * stops as soon as stopped() is true.
+ *
+ * In the library (see fimcp_api.hh) the solutions go to a callback
+ * instead, the engines then do not depend on the options or on output.
+ *
+ */
+class Fimcp_native {
+protected:
+  /// the dataset
+  const Dataset& data;
+  /// minimal frequency
+  int freq;
+  /// print itemsets?
+  PrintStyle print_itemsets;
+  /// writer to print to
+  SolutionWriter* writer;
+  /// stop after this many solutions (0: all)
+  unsigned int max_sols;
+  /// only report supports below this (0: all), see ResultStore
+  int below;
+  /// gets the solutions instead of the writer, if set (library)
+  Fimcp_callback callback;
+  /// transactions of a solution are needed
+  bool tids_needed;
+  /// the callback asked to stop
+  bool halted;
+  /// transactions of a solution, for the callback
+  vector<word_t> bitmap;
+
+  /// statistics
+  unsigned long nodes;
+  unsigned long sols;
+  int depth_max;
+
+  /// candidate and nr of candidates at every depth of the current path,
+  /// last tick seen and nodes sampled (see Progress)
+  vector< pair<int,int> > progress_path;
+  unsigned int progress_seen;
+  unsigned long progress_nodes;
+  /// Candidate \a k of the \a n at \a depth is expanded
+  void progress(int depth, int k, int n) {
+    if (!Progress::enabled())
+      return;
+    if ((int)progress_path.size() <= depth)
+      progress_path.resize(depth+1);
+    progress_path[depth] = make_pair(k, n);
+    if (Progress::due(progress_seen))
+      progress_sample(depth);
+  }
+  /// Publish the progress at \a depth
+  void progress_sample(int depth);
+
+  /// Solution limit reached?
+  bool stopped(void) const {
+    return (max_sols != 0 && sols >= max_sols) || halted ||
+      (writer != NULL && writer->failed());
+  }
+  /// Report itemset \a items (sorted) with support \a supp, \a tids only needed for full output
+  void report(const vector<int>& items, int supp, const vector<int>& tids);
+  /// Does the output need the transactions of every solution?
+  bool need_tids(void) const {
+    return tids_needed;
+  }
+public:
+  /// Engine for \a data with the settings of \a opt (the model binaries)
+  Fimcp_native(const Options_fimcp& opt, const Dataset& data);
+  /// Engine for \a data with minimal support \a freq, calling \a cb for
+  /// every solution, with its transactions if \a tids (the library)
+  Fimcp_native(const Dataset& data, int freq, const Fimcp_callback& cb, bool tids);
+  virtual ~Fimcp_native(void) {}
+  /// Enumerate all solutions
+  virtual void run(void) = 0;
+  /// Memory in use by the engine, in bytes
+  virtual size_t memory(void) const = 0;
+  /// Print the search statistics of engine \a name
+  void statistics(const char* name, double runtime) const;
+  /// Nr of search nodes
+  unsigned long nr_nodes(void) const { return nodes; }
+  /// Nr of solutions reported
+  unsigned long nr_solutions(void) const { return sols; }
+
+  /// Read the data of \a opt, run engine \a Engine and print the statistics
+  template<class Engine>
+  static void solve(const Options_fimcp& opt, const char* name);
+};
+
+/// Engine for \a d with the settings of \a opt (in the header: the library
+/// does not have Fimcp_basic)
+inline
+Fimcp_native::Fimcp_native(const Options_fimcp& opt, const Dataset& d) :
+    data(d),
+    freq(opt.getFreq(d.nr_t)),
+    print_itemsets(Fimcp_basic::print_style(opt)),
+    writer(Fimcp_basic::solution_writer(opt)),
+    max_sols(opt.solutions()),
+    below(opt.supp_below()),
+    tids_needed(print_itemsets == PRINT_FULL || print_itemsets == PRINT_BINFULL),
+    halted(false),
+    nodes(0), sols(0), depth_max(0),
+    progress_seen(0), progress_nodes(0) {
+    data.print_info(opt.datafile(), freq);
+    if (data.classes.size() != 0)
+        fprintf(stdout, " Warning: class labels found, ignored.\n");
+    writer->put_header(print_itemsets, false, data.nr_i, data.nr_t);
+}
+
+template<class Engine>
+void Fimcp_native::solve(const Options_fimcp& opt, const char* name) {
+    fprintf(stdout, "%s\n", opt.name());
+    if (Fimcp_basic::print_style(opt) == PRINT_CPVARS) {
+        fprintf(stderr, "\tError: -output cpvars needs -engine cp !\n");
+        exit(1);
+    }
+    if (strcmp(opt.batch(),"") != 0) {
+        fprintf(stderr, "\tError: -batch needs -engine cp !\n");
+        exit(1);
+    }
+    if (Checkpoint::enabled() && strcmp(name, "eclat") != 0) {
+        fprintf(stderr, "\tError: -checkpoint needs -engine eclat or cp !\n");
+        exit(1);
+    }
+    const Dataset& data = Dataset::get(opt.datafile());
+    Engine* engine;
+    {
+        Phases::Timer timer(Phases::MATRIX);
+        engine = new Engine(opt, data);
+    }
+    Phases::Timer timer(Phases::SEARCH);
+    Support::Timer t;
+    t.start();
+    engine->run();
+    Progress::disable();
+    Checkpoint::finish();
+    engine->statistics(name, t.stop());
+    delete engine;
+}
+
+#endif
@@ -0,0 +1,328 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_HYBRID__
+#define __FIMCP_COMMON_HYBRID__
+
+#include "hybrid.hh"
+#include "phases.hh"
+#include "progress.hh"
+
+#include <algorithm>
+
+/// all hybrid searches of this process, for the statistics at exit
+static vector<HybridData*> hybrids;
+
+HybridData::HybridData(const vector< vector<bool> >& tdb, int f, const vector<HybridSide>& s,
+                       PrintStyle p, SolutionWriter* w) :
+    nr_i(tdb.size() == 0 ? 0 : tdb[0].size()),
+    nr_t(tdb.size()),
+    nr_words(tidset_words(nr_t)),
+    freq(f),
+    side(s),
+    print_itemsets(p),
+    writer(w),
+    handoffs(0), sols(0) {
+    sets.assign(nr_i*nr_words, 0);
+    for (int t=0; t!=nr_t; t++) {
+        for (int i=0; i!=nr_i; i++) {
+            if (tdb[t][i])
+                sets[i*nr_words + t/WORD_BITS] |= (word_t)1 << (t%WORD_BITS);
+        }
+    }
+    cover.resize(nr_words);
+}
+
+/// Print the statistics of all hybrid searches
+void HybridData::statistics(void) {
+    unsigned long handoffs = 0, sols = 0;
+    for (unsigned int h=0; h!=hybrids.size(); h++) {
+        handoffs += hybrids[h]->handoffs;
+        sols += hybrids[h]->sols;
+    }
+    fprintf(stdout, " hybrid: %lu solutions enumerated natively in %lu subtrees\n", sols, handoffs);
+}
+
+/// Are all side constraints entailed by the bounds of \a items?
+bool HybridData::entailed(const ViewArray<Int::BoolView>& items) const {
+    for (unsigned int s=0; s!=side.size(); s++) {
+        const vector<int>& coef = side[s].coef;
+        // bounds of the sum
+        long lo = 0, hi = 0;
+        for (int i=0; i!=nr_i; i++) {
+            if (items[i].one()) {
+                lo += coef[i];
+                hi += coef[i];
+            } else if (items[i].none()) {
+                if (coef[i] < 0)
+                    lo += coef[i];
+                else
+                    hi += coef[i];
+            }
+        }
+        long val = side[s].val;
+        bool ok = false;
+        switch (side[s].rel) {
+        case IRT_EQ: ok = (lo == val && hi == val); break;
+        case IRT_NQ: ok = (hi < val || lo > val); break;
+        case IRT_LQ: ok = (hi <= val); break;
+        case IRT_LE: ok = (hi < val); break;
+        case IRT_GQ: ok = (lo >= val); break;
+        case IRT_GR: ok = (lo > val); break;
+        }
+        if (!ok)
+            return false;
+    }
+    return true;
+}
+
+/// Report the current itemset with tidset \a set
+void HybridData::report(const word_t* set, int supp) {
+    sols++;
+    Progress::solution();
+    if (print_itemsets == PRINT_NONE)
+        return;
+    Phases::Timer timer(Phases::PRINT);
+    sorted = prefix;
+    sort(sorted.begin(), sorted.end());
+    tids.clear();
+    if (print_itemsets == PRINT_FULL || print_itemsets == PRINT_BINFULL)
+        tidset_list(set, nr_words, tids);
+    writer->put_solution(print_itemsets, sorted, false, supp, 0, tids, nr_t);
+}
+
+/// Extend the current itemset with the \a n candidates at \a depth
+void HybridData::expand(int depth, int n) {
+    const vector<int>& items = cands[depth];
+    const vector<word_t>& set = levels[depth];
+    for (int k=0; k!=n; k++) {
+        prefix.push_back(items[k]);
+        report(&set[k*nr_words], supps[depth][k]);
+
+        cands[depth+1].clear();
+        supps[depth+1].clear();
+        vector<word_t>& next = levels[depth+1];
+        if (next.size() < (size_t)(n-k-1)*nr_words)
+            next.resize((n-k-1)*nr_words);
+        int m = 0;
+        for (int j=k+1; j!=n; j++) {
+            int supp = tidset_and(&next[m*nr_words], &set[k*nr_words], &set[j*nr_words], nr_words);
+            if (supp >= freq) {
+                cands[depth+1].push_back(items[j]);
+                supps[depth+1].push_back(supp);
+                m++;
+            }
+        }
+        if (m != 0)
+            expand(depth+1, m);
+        prefix.pop_back();
+    }
+}
+
+/// Enumerate all solutions below the current node
+void HybridData::enumerate(const ViewArray<Int::BoolView>& items,
+                           const ViewArray<Int::BoolView>& trans) {
+    handoffs++;
+
+    // the node: its items and cover
+    prefix.clear();
+    for (int i=0; i!=nr_i; i++) {
+        if (items[i].one())
+            prefix.push_back(i);
+    }
+    for (int w=0; w!=nr_words; w++)
+        cover[w] = 0;
+    int supp = 0;
+    for (int t=0; t!=nr_t; t++) {
+        if (!trans[t].zero()) {
+            cover[t/WORD_BITS] |= (word_t)1 << (t%WORD_BITS);
+            supp++;
+        }
+    }
+    report(&cover[0], supp);
+
+    // the free items that are frequent in the cover
+    int n = 0;
+    for (int i=0; i!=nr_i; i++)
+        n += items[i].none();
+    if (cands.size() < (size_t)n+1) {
+        cands.resize(n+1);
+        supps.resize(n+1);
+        levels.resize(n+1);
+    }
+    cands[0].clear();
+    supps[0].clear();
+    if (levels[0].size() < (size_t)n*nr_words)
+        levels[0].resize(n*nr_words);
+    int m = 0;
+    for (int i=0; i!=nr_i; i++) {
+        if (!items[i].none())
+            continue;
+        int s = tidset_and(&levels[0][m*nr_words], &sets[i*nr_words], &cover[0], nr_words);
+        if (s >= freq) {
+            cands[0].push_back(i);
+            supps[0].push_back(s);
+            m++;
+        }
+    }
+    if (m != 0)
+        expand(0, m);
+}
+
+
+/// Choice of the hybrid brancher: the native handoff, or an item and its value
+class HybridChoice : public Choice {
+public:
+  /// the item branched on, -1 for the handoff
+  int pos;
+  /// the value tried first
+  int val;
+  HybridChoice(const Brancher& b, int p, int v)
+    : Choice(b, p < 0 ? 1 : 2), pos(p), val(v) {}
+  virtual size_t size(void) const {
+    return sizeof(HybridChoice);
+  }
+};
+
+/**
+ * \brief Brancher on the items that hands the subtree to the native
+ * search once the side constraints are entailed
+ *
+ * It replaces the branching on the items: while an item is free it
+ * either enumerates the subtree natively and fails the node (side
+ * constraints entailed), or branches on the next item with the
+ * variable and value selection of -branching and -branchval.
+ *
+ */
+class Hybrid : public Brancher {
+protected:
+  ViewArray<Int::BoolView> items;
+  ViewArray<Int::BoolView> trans;
+  /// shared, not copied
+  HybridData* data;
+  /// variable and value selection
+  IntVarBranch varsel;
+  IntValBranch valsel;
+  /// items before start are assigned
+  mutable int start;
+
+  /// Constructor for cloning \a b
+  Hybrid(Space& home, bool share, Hybrid& b)
+    : Brancher(home, share, b), data(b.data),
+      varsel(b.varsel), valsel(b.valsel), start(b.start) {
+    items.update(home, share, b.items);
+    trans.update(home, share, b.trans);
+  }
+  /// The item to branch on (the items are Boolean: only degree breaks ties)
+  int select(void) const {
+    int best = start;
+    for (int i=start+1; i<items.size(); i++) {
+      if (!items[i].none())
+        continue;
+      if ((varsel == INT_VAR_DEGREE_MAX || varsel == INT_VAR_SIZE_DEGREE_MIN) &&
+          items[i].degree() > items[best].degree())
+        best = i;
+      else if ((varsel == INT_VAR_DEGREE_MIN || varsel == INT_VAR_SIZE_DEGREE_MAX) &&
+               items[i].degree() < items[best].degree())
+        best = i;
+    }
+    return best;
+  }
+public:
+  /// Constructor for creation
+  Hybrid(Home home, ViewArray<Int::BoolView>& x, ViewArray<Int::BoolView>& t, HybridData* d,
+         IntVarBranch vars, IntValBranch vals)
+    : Brancher(home), items(x), trans(t), data(d), varsel(vars), valsel(vals), start(0) {}
+  /// Is an item free?
+  virtual bool status(const Space&) const {
+    for (; start<items.size(); start++) {
+      if (items[start].none())
+        return true;
+    }
+    return false;
+  }
+  /// Handoff when the side constraints are entailed, else the next item
+  virtual const Choice* choice(Space&) {
+    if (data->entailed(items)) {
+      data->enumerate(items, trans);
+      return new HybridChoice(*this, -1, 0);
+    }
+    return new HybridChoice(*this, select(), valsel == INT_VAL_MAX ? 1 : 0);
+  }
+  /// The handoff fails, the item is set to its value or the other one
+  virtual ExecStatus commit(Space& home, const Choice& _c, unsigned int a) {
+    const HybridChoice& c = static_cast<const HybridChoice&>(_c);
+    if (c.pos < 0)
+      return ES_FAILED;
+    int v = (a == 0) ? c.val : 1-c.val;
+    return me_failed(items[c.pos].eq(home, v)) ? ES_FAILED : ES_OK;
+  }
+  virtual Actor* copy(Space& home, bool share) {
+    return new (home) Hybrid(home, share, *this);
+  }
+  virtual size_t dispose(Space& home) {
+    (void) Brancher::dispose(home);
+    return sizeof(*this);
+  }
+};
+
+/// Post the hybrid brancher on \a items for \a side
+bool hybrid(Home home, const Options_fimcp& opt,
+            const BoolVarArgs& items, const BoolVarArgs& transactions,
+            const vector< vector<bool> >& tdb, const vector<HybridSide>& side,
+            PrintStyle print_itemsets, SolutionWriter* writer) {
+    if (opt.threads() != 1.0) {
+        fprintf(stdout, " Warning: -hybrid needs a single thread, ignored.\n");
+        return false;
+    }
+    if (print_itemsets == PRINT_CPVARS) {
+        fprintf(stdout, " Warning: -hybrid can not print cpvars, ignored.\n");
+        return false;
+    }
+    if (opt.supp_below() != 0) {
+        fprintf(stdout, " Warning: -hybrid can not extend a stored result, ignored.\n");
+        return false;
+    }
+    if (hybrids.size() == 0)
+        atexit(HybridData::statistics);
+    HybridData* data = new HybridData(tdb, opt.getFreq(tdb.size()), side, print_itemsets, writer);
+    hybrids.push_back(data);
+
+    ViewArray<Int::BoolView> x(home, items);
+    ViewArray<Int::BoolView> t(home, transactions);
+    (void) new (home) Hybrid(home, x, t, data,
+                             (IntVarBranch)opt.branching(), (IntValBranch)opt.branchval());
+    return true;
+}
+
+#endif
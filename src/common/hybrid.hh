@@ -0,0 +1,113 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_HYBRID_HH__
+#define __FIMCP_COMMON_HYBRID_HH__
+
+#include "fimcp_basic.hh"
+#include "tidset.hh"
+
+/**
+ * \brief Hybrid CP/native search
+ *
+ * For models that are standard frequent itemset mining plus linear side
+ * constraints on the items (size, cost). As soon as the side constraints
+ * are entailed by the bounds of the items, the rest of the subtree is
+ * plain frequent itemset mining on the current cover: the hybrid
+ * brancher (posted instead of the branching on the items) enumerates it
+ * with tid-bitsets, writes those solutions itself and fails the node, so
+ * that Gecode no longer clones and propagates the full model there.
+ *
+ * Solutions of the native part are written with the same writer, in the
+ * same format, but are not in Gecode's summary: they are counted on the
+ * line ' hybrid: ...' at exit. Needs a single search thread.
+ *
+ */
+
+/// A side constraint sum(coef[i]*item_i) rel val
+struct HybridSide {
+  vector<int> coef;
+  IntRelType rel;
+  int val;
+  HybridSide(const vector<int>& c, IntRelType r, int v) : coef(c), rel(r), val(v) {}
+};
+
+/// Data of the hybrid search, shared by all spaces
+class HybridData {
+protected:
+  int nr_i;
+  int nr_t;
+  int nr_words;
+  int freq;
+  /// tidset of every item
+  vector<word_t> sets;
+  /// the side constraints
+  vector<HybridSide> side;
+  /// output
+  PrintStyle print_itemsets;
+  SolutionWriter* writer;
+  /// cover of the current node
+  vector<word_t> cover;
+  /// candidates at every depth of the enumeration: items, support, tidsets
+  vector< vector<int> > cands;
+  vector< vector<int> > supps;
+  vector< vector<word_t> > levels;
+  /// current itemset, scratch space for report()
+  vector<int> prefix, sorted, tids;
+
+  /// Report the current itemset with tidset \a set
+  void report(const word_t* set, int supp);
+  /// Extend the current itemset with the \a n candidates at \a depth
+  void expand(int depth, int n);
+public:
+  /// statistics
+  unsigned long handoffs;
+  unsigned long sols;
+
+  HybridData(const vector< vector<bool> >& tdb, int freq, const vector<HybridSide>& side,
+             PrintStyle print_itemsets, SolutionWriter* writer);
+  /// Print the statistics of all hybrid searches
+  static void statistics(void);
+  /// Are all side constraints entailed by the bounds of \a items?
+  bool entailed(const ViewArray<Int::BoolView>& items) const;
+  /// Enumerate all solutions below the current node
+  void enumerate(const ViewArray<Int::BoolView>& items, const ViewArray<Int::BoolView>& trans);
+};
+
+/// Post the hybrid brancher on \a items for \a side, false if it can not be used
+bool hybrid(Home home, const Options_fimcp& opt,
+            const BoolVarArgs& items, const BoolVarArgs& transactions,
+            const vector< vector<bool> >& tdb, const vector<HybridSide>& side,
+            PrintStyle print_itemsets, SolutionWriter* writer);
+
+#endif
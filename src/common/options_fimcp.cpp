@@ -35,6 +35,9 @@
 #define __FIMCP_COMMON_OPTIONS__
 
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
 #include <vector>
 using namespace std;
 #include <gecode/driver.hh>
@@ -42,12 +45,36 @@ using namespace Gecode;
 #include "textoption.hh"
 #include "stringuintoption.hh"
 #include "floatoption.hh"
+#include "phases.hh"
+#include "progress.hh"
+#include "checkpoint.hh"
 
 enum OutputType {
     OUT_NONE,
     OUT_FIMI,
     OUT_FULL,
     OUT_CPVARS,
+    OUT_BINARY,
+    OUT_BINFULL,
+    OUT_DELTA,
+};
+
+enum EngineType {
+    ENGINE_CP,
+    ENGINE_ECLAT,
+    ENGINE_LCM,
+    ENGINE_AUTO,
+};
+
+enum VerticalType {
+    VERT_AUTO,
+    VERT_TIDSET,
+    VERT_DIFFSET,
+};
+
+enum SampleType {
+    SAMPLE_UNIFORM,
+    SAMPLE_STRATIFIED,
 };
 
 /**
@@ -58,8 +85,12 @@ class Options_fimcp : public Options {
 protected:
     StringOption _branchval;
     StringOption _output;
+    StringOption _engine;
+    StringOption _vertical;
+    StringOption _approxsample;
 
     vector<BaseOption*> _list_specific;
+    vector<string> _given;
     const char* _description;
     const char* _usage;
 
@@ -67,7 +98,28 @@ protected:
     TextOption _datafile;
     TextOption _attrfile;
     TextOption _solfile;
+    UnsignedIntOption _outring;
+    TextOption _timing;
+    UnsignedIntOption _progress;
+    UnsignedIntOption _membudget;
+    TextOption _checkpoint;
+    UnsignedIntOption _checkpointevery;
+    FloatOption _approx;
+    FloatOption _approxdelta;
+    UnsignedIntOption _approxverify;
+    UnsignedIntOption _approxseed;
+    TextOption _shape;
+    TextOption _trace;
+    UnsignedIntOption _tracesample;
     UnsignedIntOption _cclause;
+    UnsignedIntOption _plan;
+    UnsignedIntOption _hybrid;
+    UnsignedIntOption _profile;
+    TextOption _batch;
+    TextOption _store;
+    TextOption _model;
+    TextOption _serve;
+    UnsignedIntOption _workers;
     FloatOption _freq;
     FloatOption _infreq;
     StringUIntOption _bound1;
@@ -76,18 +128,46 @@ protected:
     UnsignedIntOption _beta;
     FloatOption _delta;
     FloatOption _epsilon;
+    /// only search supports below this (0: no bound), set by ResultStore
+    unsigned int _below;
+    /// the options of a request, answered on its connection (see Server)
+    bool _request;
 public:
   /// Initialize options for example with name \a e
   Options_fimcp(const char* e)
   : Options(e)
   , _branchval("-branchval", "branch value variants", INT_VAL_MAX)
   , _output("-output", "type of output of solutions", OUT_FIMI)
+  , _engine("-engine", "search engine to use", ENGINE_CP)
+  , _vertical("-vertical", "transaction sets of the native engine", VERT_AUTO)
+  , _approxsample("-approxsample", "how -approx draws the sample", SAMPLE_UNIFORM)
   , _list_specific()
   // defaults (must be add_specific() to be used)
   , _datafile("-datafile", "filename of dataset to use (any name)", "example.txt")
   , _attrfile("-attrfile", "filename of attributes to use (any name)", "")
   , _solfile("-solfile", "filename to write solutions to (any name)", "")
+  , _outring("-outring", "nr of 1MB buffers to write the solfile from a separate thread (0: no thread)", 8)
+  , _timing("-timing", "time and memory of every phase: - prints a summary line at exit, else JSON file to write", "")
+  , _progress("-progress", "print the progress of the search on stderr every this many seconds (0: never)", 0)
+  , _membudget("-membudget", "memory budget in MB: recompute instead of copying, and spill tidsets to diffsets, near it (0: none)", 0)
+  , _checkpoint("-checkpoint", "file to checkpoint the search to, resumed when it exists (see common/checkpoint.hh)", "")
+  , _checkpointevery("-checkpointevery", "write a checkpoint every this many seconds", 60)
+  , _approx("-approx", "mine a sample, every frequency within this of that in the data (see common/approximate.hh, 0: exact)", 0)
+  , _approxdelta("-approxdelta", "probability that the sample of -approx is less accurate", 0.05)
+  , _approxverify("-approxverify", "count the solutions of -approx in the data, drop the infrequent ones ?", 0)
+  , _approxseed("-approxseed", "seed of the sample of -approx", 1)
+  , _shape("-shape", "shape of the search tree per depth (see common/tree_shape.hh): - prints a table, else JSON file to write", "")
+  , _trace("-trace", "JSON lines file to write a sample of the search tree nodes to", "")
+  , _tracesample("-tracesample", "write one in every this many nodes to the -trace file", 100)
   , _cclause("-cclause", "coverage constraint using clause ?", 1)
+  , _plan("-plan", "choose the options not given from the dataset statistics ?", 1)
+  , _hybrid("-hybrid", "enumerate natively once the side constraints are entailed ?", 0)
+  , _profile("-profile", "profile the propagation of every constraint block (see common/block_profile.hh) ?", 0)
+  , _batch("-batch", "settings to mine in one run: thresholds \"0.1 0.05\" or \"freq=0.1,delta=0.1;freq=0.2,delta=0.2\"", "")
+  , _store("-store", "directory of stored results, reused when only the frequency changes", "")
+  , _model("-model", "constraint blocks to combine, eg closed+cost (see common/fimcp_blocks.hh)", "standard")
+  , _serve("-serve", "serve mining requests on this unix socket (see common/server.hh)", "")
+  , _workers("-workers", "nr of requests served at the same time", 4)
   , _freq("-freq", "frequency (>1 is absolute, <1 is percentage, eg 0.10 is 10%)", 0.10)
   , _infreq("-infreq", "frequency (>1 is absolute, <1 is percentage, eg 0.10 is 10%)", 0.10)
   , _bound1("-bound1", "bound parameters: eg GQ 0", IRT_GQ, 0)
@@ -95,7 +175,9 @@ public:
   , _alpha("-alpha", "alpha parameter", 0)
   , _beta("-beta", "beta parameter", 0)
   , _delta("-delta", "delta parameter", 0.0)
-  , _epsilon("-epsilon", "epsilon parameter", 0.0) {
+  , _epsilon("-epsilon", "epsilon parameter", 0.0)
+  , _below(0)
+  , _request(false) {
 
   // set defaults
   solutions(0);
@@ -143,19 +225,55 @@ public:
   _output.add(OUT_FIMI, "normal", "print solutions (FIMI-style)");
   _output.add(OUT_FULL, "full", "print solutions (FIMI-style) and transaction sets");
   _output.add(OUT_CPVARS, "cpvars", "print the CP variables of the solutions)");
+  _output.add(OUT_BINARY, "binary", "write solutions in compact binary form (see tools/fimcp_decode)");
+  _output.add(OUT_BINFULL, "binaryfull", "write solutions and transaction sets in compact binary form");
+  _output.add(OUT_DELTA, "delta", "print every solution as delta on the previous one: nr of items to pop, items to push (see tools/fimcp_decode)");
   add_specific(_output);
   add_specific(_cclause);
+  add_specific(_plan);
+
+  _engine.add(ENGINE_CP, "cp", "constraint programming (Gecode), supports everything");
+  _engine.add(ENGINE_ECLAT, "eclat", "native frequent itemset miner (depth-first tid-bitset intersection)");
+  _engine.add(ENGINE_LCM, "lcm", "native closed itemset miner (prefix-preserving closure extension)");
+  _engine.add(ENGINE_AUTO, "auto", "the native engine of the model if the other options allow it, else cp");
+
+  _vertical.add(VERT_AUTO, "auto", "tidsets, diffsets in the dense parts of the search");
+  _vertical.add(VERT_TIDSET, "tidset", "bitsets of the covered transactions");
+  _vertical.add(VERT_DIFFSET, "diffset", "lists of the transactions lost w.r.t. the parent (dEclat)");
+
+  _approxsample.add(SAMPLE_UNIFORM, "uniform", "transactions drawn uniformly, without replacement");
+  _approxsample.add(SAMPLE_STRATIFIED, "stratified", "the same fraction of every class (or transaction size)");
 
   add_specific(_datafile);
   add_specific(_solfile);
+  add_specific(_outring);
+  add_specific(_timing);
+  add_specific(_progress);
+  add_specific(_membudget);
+  add_specific(_checkpoint);
+  add_specific(_checkpointevery);
+  add_specific(_shape);
+  add_specific(_trace);
+  add_specific(_tracesample);
 }
 
   // add the option to our accessible vector
   // for help that uses friend in BaseOption, grrr
   inline void add_specific(BaseOption& o) {
+    for (unsigned int i = 0; i != _list_specific.size(); i++)
+      if (_list_specific[i] == &o)
+        return;
     _list_specific.push_back(&o);
   }
 
+  /// Was option \a o (eg "-cclause") given on the command line?
+  inline bool given(const char* o) const {
+    for (unsigned int i = 0; i != _given.size(); i++)
+      if (_given[i] == o)
+        return true;
+    return false;
+  }
+
   // branchval (considered part of gecode options)
   inline void branchval(int v) {
     _branchval.value(v);
@@ -173,6 +291,24 @@ public:
     return _output.value();
   }
 
+  // engine
+  inline void engine(int v) {
+    _engine.value(v);
+    add_specific(_engine);
+  }
+  inline int engine(void) const {
+    return _engine.value();
+  }
+
+  // vertical
+  inline void vertical(int v) {
+    _vertical.value(v);
+    add_specific(_vertical);
+  }
+  inline int vertical(void) const {
+    return _vertical.value();
+  }
+
   // FIM_CP options (added after mark)
   // datafile
   inline void datafile(const char* s) {
@@ -201,6 +337,136 @@ public:
     return _solfile.value();
   }
 
+  // outring
+  inline void outring(unsigned int v) {
+    _outring.value(v);
+    //add_specific() this one is added in constructor
+  }
+  inline unsigned int outring(void) const {
+    return _outring.value();
+  }
+
+  // timing
+  inline void timing(const char* v) {
+    _timing.value(v);
+    //add_specific() this one is added in constructor
+  }
+  inline const char* timing(void) const {
+    return _timing.value();
+  }
+
+  // progress
+  inline void progress(unsigned int v) {
+    _progress.value(v);
+    //add_specific() this one is added in constructor
+  }
+  inline unsigned int progress(void) const {
+    return _progress.value();
+  }
+
+  // membudget
+  inline void membudget(unsigned int v) {
+    _membudget.value(v);
+    //add_specific() this one is added in constructor
+  }
+  inline unsigned int membudget(void) const {
+    return _membudget.value();
+  }
+
+  // checkpoint
+  inline void checkpoint(const char* v) {
+    _checkpoint.value(v);
+    //add_specific() this one is added in constructor
+  }
+  inline const char* checkpoint(void) const {
+    return _checkpoint.value();
+  }
+
+  // checkpointevery
+  inline void checkpointevery(unsigned int v) {
+    _checkpointevery.value(v);
+    //add_specific() this one is added in constructor
+  }
+  inline unsigned int checkpointevery(void) const {
+    return _checkpointevery.value();
+  }
+
+  // approx, with the options of its sample (see Approximate)
+  inline void approx(float v) {
+    _approx.value(v);
+    add_specific(_approx);
+    add_specific(_approxdelta);
+    add_specific(_approxsample);
+    add_specific(_approxverify);
+    add_specific(_approxseed);
+  }
+  inline float approx(void) const {
+    return _approx.value();
+  }
+
+  // approxdelta
+  inline void approxdelta(float v) {
+    _approxdelta.value(v);
+    //add_specific() this one is added by approx()
+  }
+  inline float approxdelta(void) const {
+    return _approxdelta.value();
+  }
+
+  // approxsample
+  inline void approxsample(int v) {
+    _approxsample.value(v);
+    //add_specific() this one is added by approx()
+  }
+  inline int approxsample(void) const {
+    return _approxsample.value();
+  }
+
+  // approxverify
+  inline void approxverify(unsigned int v) {
+    _approxverify.value(v);
+    //add_specific() this one is added by approx()
+  }
+  inline unsigned int approxverify(void) const {
+    return _approxverify.value();
+  }
+
+  // approxseed
+  inline void approxseed(unsigned int v) {
+    _approxseed.value(v);
+    //add_specific() this one is added by approx()
+  }
+  inline unsigned int approxseed(void) const {
+    return _approxseed.value();
+  }
+
+  // shape
+  inline void shape(const char* v) {
+    _shape.value(v);
+    //add_specific() this one is added in constructor
+  }
+  inline const char* shape(void) const {
+    return _shape.value();
+  }
+
+  // trace
+  inline void trace(const char* v) {
+    _trace.value(v);
+    //add_specific() this one is added in constructor
+  }
+  inline const char* trace(void) const {
+    return _trace.value();
+  }
+
+  // tracesample
+  inline void tracesample(unsigned int v) {
+    _tracesample.value(v);
+    //add_specific() this one is added in constructor
+  }
+  inline unsigned int tracesample(void) const {
+    return _tracesample.value();
+  }
+
   // cclause
   inline void cclause(unsigned int v) {
     _cclause.value(v);
@@ -210,11 +476,99 @@ public:
     return _cclause.value();
   }
 
+  // plan
+  inline void plan(unsigned int v) {
+    _plan.value(v);
+    //add_specific() this one is added in constructor
+  }
+  inline unsigned int plan(void) const {
+    return _plan.value();
+  }
+
+  // hybrid
+  inline void hybrid(unsigned int v) {
+    _hybrid.value(v);
+    add_specific(_hybrid);
+  }
+  inline unsigned int hybrid(void) const {
+    return _hybrid.value();
+  }
+
+  // profile
+  inline void profile(unsigned int v) {
+    _profile.value(v);
+    add_specific(_profile);
+  }
+  inline unsigned int profile(void) const {
+    return _profile.value();
+  }
+
+  // batch
+  inline void batch(const char* v) {
+    _batch.value(v);
+    add_specific(_batch);
+  }
+  inline const char* batch(void) const {
+    return _batch.value();
+  }
+
+  // store
+  inline void store(const char* v) {
+    _store.value(v);
+    add_specific(_store);
+  }
+  inline const char* store(void) const {
+    return _store.value();
+  }
+
+  // model
+  inline void model(const char* v) {
+    _model.value(v);
+    add_specific(_model);
+  }
+  inline const char* model(void) const {
+    return _model.value();
+  }
+
+  // serve
+  inline void serve(const char* v) {
+    _serve.value(v);
+    add_specific(_serve);
+  }
+  inline const char* serve(void) const {
+    return _serve.value();
+  }
+  // workers
+  inline void workers(unsigned int v) {
+    _workers.value(v);
+    add_specific(_workers);
+  }
+  inline unsigned int workers(void) const {
+    return _workers.value();
+  }
+  // support bound of the search (not an option, see ResultStore)
+  inline void supp_below(unsigned int v) {
+    _below = v;
+  }
+  inline unsigned int supp_below(void) const {
+    return _below;
+  }
+  // the options of a Server request (not an option): no -solfile needed
+  inline void request(bool v) {
+    _request = v;
+  }
+  inline bool request(void) const {
+    return _request;
+  }
+
   // freq
   inline void freq(float v) {
     _freq.value(v);
     add_specific(_freq);
   }
+  inline float freq(void) const {
+    return _freq.value();
+  }
   inline unsigned int getFreq(unsigned int total) const {
     if (_freq.value() < 1) {
         // < 1 means relative value
@@ -228,6 +582,9 @@ public:
     _infreq.value(v);
     add_specific(_infreq);
   }
+  inline float infreq(void) const {
+    return _infreq.value();
+  }
   inline unsigned int getInfreq(unsigned int total) const {
     if (_infreq.value() < 1) {
         // < 1 means relative value
@@ -300,6 +657,16 @@ public:
     return _epsilon.value();
   }
 
+  /// The options that change the solutions, other than -freq and -datafile
+  string constraint_params(void) const {
+    char buf[1024];
+    snprintf(buf, sizeof(buf),
+             "model=%s infreq=%g delta=%g epsilon=%g alpha=%u beta=%u bound1=%d:%u bound2=%d:%u attrfile=%s",
+             _model.value(), _infreq.value(), _delta.value(), _epsilon.value(), _alpha.value(), _beta.value(),
+             _bound1.oper(), _bound1.value(), _bound2.oper(), _bound2.value(), _attrfile.value());
+    return buf;
+  }
+
   // description
   inline void description(const char* s) {
     _description = s;
@@ -314,6 +681,12 @@ public:
   /// Parse options from arguments \a argv (number is \a argc)
   void parse(int& argc, char* argv[]) {
     int x = _list_specific.size();
+    string command = name();
+    for (int i = 1; i < argc; i++) {
+      if (argv[i][0] == '-')
+        _given.push_back(argv[i]);
+      command = command + " " + argv[i];
+    }
 
   // horrible code needs horrible goto (copy from original code)
   next:
@@ -322,6 +695,94 @@ public:
     for (int i = 0; i != x; i++)
       if (_list_specific[i]->parse(argc,argv))
         goto next;
+
+    // not an option of this binary (eg -approx in more/): it would be ignored
+    // (a request reports it on its connection, see Server)
+    if (argc > 1 && !request()) {
+      fprintf(stderr, "\tError: unknown option %s !\n", argv[1]);
+      exit(1);
+    }
+
+    if (strcmp(timing(),"") != 0)
+      Phases::enable(timing(), name());
+    if (progress() != 0)
+      Progress::enable(progress());
+    if (strcmp(checkpoint(),"") != 0) {
+      if (strcmp(solfile(),"") == 0) {
+        fprintf(stderr, "\tError: -checkpoint needs a -solfile !\n");
+        exit(1);
+      }
+      Checkpoint::enable(checkpoint(), checkpointevery(), command);
+    }
+    // on stdout binary and delta solutions would be mixed with the search
+    // summary, a batch writes them to a file per setting, a request to its
+    // connection
+    if ((output() == OUT_BINARY || output() == OUT_BINFULL || output() == OUT_DELTA) &&
+        strcmp(solfile(),"") == 0 && strcmp(batch(),"") == 0 && !request()) {
+      fprintf(stderr, "\tError: -output binary, binaryfull and delta need a -solfile !\n");
+      exit(1);
+    }
+  }
+
+  /// The values of the options a -batch setting may change (see Batch)
+  struct Thresholds {
+    float freq, infreq, delta, epsilon;
+    unsigned int alpha, beta;
+    int bound1_op, bound2_op;
+    unsigned int bound1_val, bound2_val;
+  };
+  /// The current thresholds
+  Thresholds thresholds(void) const {
+    Thresholds t;
+    t.freq = _freq.value();
+    t.infreq = _infreq.value();
+    t.delta = _delta.value();
+    t.epsilon = _epsilon.value();
+    t.alpha = _alpha.value();
+    t.beta = _beta.value();
+    t.bound1_op = _bound1.oper();
+    t.bound1_val = _bound1.value();
+    t.bound2_op = _bound2.oper();
+    t.bound2_val = _bound2.value();
+    return t;
+  }
+  /// Go back to thresholds \a t
+  void thresholds(const Thresholds& t) {
+    _freq.value(t.freq);
+    _infreq.value(t.infreq);
+    _delta.value(t.delta);
+    _epsilon.value(t.epsilon);
+    _alpha.value(t.alpha);
+    _beta.value(t.beta);
+    _bound1.oper(t.bound1_op);
+    _bound1.value(t.bound1_val);
+    _bound2.oper(t.bound2_op);
+    _bound2.value(t.bound2_val);
+  }
+
+  /// Set option \a o (eg "-freq") to \a v as if given on the command line, false if unknown
+  bool set(const char* o, const string& v) {
+    // the words of v stay around: text options keep pointers to them
+    static vector<char*> words;
+    vector<char*> argv;
+    argv.push_back((char*)name());
+    argv.push_back((char*)o);
+    for (size_t k = 0; k < v.size(); ) {
+      size_t e = v.find(' ', k);
+      if (e == string::npos)
+        e = v.size();
+      if (e != k) {
+        words.push_back(strdup(v.substr(k, e-k).c_str()));
+        argv.push_back(words.back());
+      }
+      k = e+1;
+    }
+    argv.push_back(NULL);
+    int argc = argv.size()-1;
+    for (unsigned int i = 0; i != _list_specific.size(); i++)
+      if (_list_specific[i]->parse(argc, &argv[0]))
+        return true;
+    return false;
   }
 
   virtual void help(void) {
@@ -0,0 +1,140 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_PHASES__
+#define __FIMCP_COMMON_PHASES__
+
+#include "phases.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <sys/resource.h>
+#include <unistd.h>
+
+bool Phases::on = false;
+string Phases::file;
+string Phases::model;
+chrono::steady_clock::time_point Phases::started;
+atomic<long long> Phases::ns[NR_PHASES];
+atomic<long> Phases::count[NR_PHASES];
+atomic<long> Phases::rss_kb[NR_PHASES];
+
+/// Names of the phases, as in the output
+static const char* const phase_names[] = {"read", "matrix", "post", "search", "print"};
+
+/// The innermost timer of this thread
+static thread_local Phases::Timer* current = NULL;
+
+Phases::Timer::Timer(Phase p0) : p(p0), on(Phases::on), inner(0), outer(NULL) {
+    if (!on)
+        return;
+    outer = current;
+    current = this;
+    start = chrono::steady_clock::now();
+}
+
+Phases::Timer::~Timer(void) {
+    if (!on)
+        return;
+    long long t = chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now() - start).count();
+    current = outer;
+    if (outer != NULL)
+        outer->inner += t;
+    ns[p] += t - inner;
+    // sample the rss when it is cheap compared to the phase (not for
+    // every printed solution)
+    if (count[p]++ == 0 || t >= 1000000) {
+        long kb = rss();
+        long prev = rss_kb[p];
+        while (kb > prev && !rss_kb[p].compare_exchange_weak(prev, kb)) {}
+    }
+}
+
+void Phases::enable(const char* f, const char* m) {
+    if (on)
+        return;
+    on = true;
+    file = f;
+    model = m;
+    started = chrono::steady_clock::now();
+    atexit(report);
+}
+
+long Phases::rss(void) {
+    long pages = 0, resident = 0;
+    FILE* f = fopen("/proc/self/statm", "r");
+    if (f != NULL) {
+        if (fscanf(f, "%ld %ld", &pages, &resident) != 2)
+            resident = 0;
+        fclose(f);
+    }
+    if (resident != 0)
+        return resident * (sysconf(_SC_PAGESIZE)/1024);
+    // no /proc: the peak is the best we have
+    struct rusage u;
+    getrusage(RUSAGE_SELF, &u);
+    return u.ru_maxrss;
+}
+
+void Phases::report(void) {
+    double total = chrono::duration_cast<chrono::microseconds>(
+        chrono::steady_clock::now() - started).count() / 1000.0;
+    struct rusage u;
+    getrusage(RUSAGE_SELF, &u);
+    long peak = u.ru_maxrss; // KB on linux
+
+    if (file == "-") {
+        fprintf(stdout, " phases");
+        for (int p=0; p!=NR_PHASES; p++)
+            fprintf(stdout, " %s=%.3fms/%ldKB", phase_names[p], ns[p]/1e6, (long)rss_kb[p]);
+        fprintf(stdout, " total=%.3fms peak=%ldKB\n", total, peak);
+        fflush(stdout);
+        return;
+    }
+
+    FILE* f = fopen(file.c_str(), "w");
+    if (f == NULL) {
+        fprintf(stderr, "\tError: can not open %s !\n", file.c_str());
+        return;
+    }
+    fprintf(f, "{\"model\": \"%s\", \"phases\": {", model.c_str());
+    for (int p=0; p!=NR_PHASES; p++) {
+        fprintf(f, "%s\"%s\": {\"ms\": %.3f, \"count\": %ld, \"rss_kb\": %ld}",
+                (p == 0 ? "" : ", "), phase_names[p], ns[p]/1e6, (long)count[p], (long)rss_kb[p]);
+    }
+    fprintf(f, "}, \"total_ms\": %.3f, \"peak_rss_kb\": %ld}\n", total, peak);
+    fclose(f);
+}
+
+#endif
@@ -0,0 +1,99 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_PHASES_HH__
+#define __FIMCP_COMMON_PHASES_HH__
+
+#include <atomic>
+#include <chrono>
+#include <string>
+using namespace std;
+
+/**
+ * \brief Time and memory of the phases of a run (-timing)
+ *
+ * The phases are: reading the dataset, building the matrix and the
+ * variables (or the structures of a native engine), posting the
+ * constraints, the search and printing the solutions. A Phases::Timer
+ * measures its phase with a monotonic clock and samples the resident
+ * set size at its end. Timers nest: the time of an inner timer (eg
+ * printing during the search) only counts for the inner phase.
+ *
+ * With -timing - the phases are printed on one line at exit:
+ *   phases read=12.1ms/2048KB matrix=... total=80.3ms peak=9016KB
+ * with -timing <file> they are written to <file> as JSON.
+ *
+ * Without -timing a Timer does nothing.
+ *
+ */
+class Phases {
+public:
+  enum Phase {READ, MATRIX, POST, SEARCH, PRINT, NR_PHASES};
+
+  /// Measures phase \a p from construction to destruction
+  class Timer {
+  protected:
+    Phase p;
+    bool on;
+    chrono::steady_clock::time_point start;
+    /// time of the timers nested in this one, in ns
+    long long inner;
+    /// the enclosing timer of this thread
+    Timer* outer;
+  public:
+    Timer(Phase p);
+    ~Timer(void);
+  };
+
+  /// Measure the phases of \a model, written to \a file at exit ("-": stdout)
+  static void enable(const char* file, const char* model);
+  /// Measuring?
+  static bool enabled(void) { return on; }
+  /// Resident set size, in KB
+  static long rss(void);
+
+protected:
+  static bool on;
+  static string file;
+  static string model;
+  static chrono::steady_clock::time_point started;
+  /// per phase: time in ns, nr of timers, largest rss at the end, in KB
+  static atomic<long long> ns[NR_PHASES];
+  static atomic<long> count[NR_PHASES];
+  static atomic<long> rss_kb[NR_PHASES];
+
+  /// Print or write the phases (at exit)
+  static void report(void);
+};
+
+#endif
@@ -0,0 +1,148 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_PLANNER__
+#define __FIMCP_COMMON_PLANNER__
+
+#include "planner.hh"
+
+static const char* engine_names[] = {"cp", "eclat", "lcm", "auto"};
+static const char* vertical_names[] = {"auto", "tidset", "diffset"};
+
+/// Name of branching \a b, as in the -branching option
+static const char* branching_name(int b) {
+    switch (b) {
+    case INT_VAR_NONE: return "input";
+    case INT_VAR_MIN_MIN: return "min";
+    case INT_VAR_MIN_MAX: return "minmax";
+    case INT_VAR_MAX_MIN: return "maxmin";
+    case INT_VAR_MAX_MAX: return "max";
+    case INT_VAR_SIZE_MIN: return "size_min";
+    case INT_VAR_SIZE_MAX: return "size_max";
+    case INT_VAR_DEGREE_MIN: return "degree_min";
+    case INT_VAR_DEGREE_MAX: return "degree_max";
+    case INT_VAR_SIZE_DEGREE_MIN: return "size_degree_min";
+    case INT_VAR_SIZE_DEGREE_MAX: return "size_degree_max";
+    case INT_VAR_REGRET_MIN_MIN: return "regret_min";
+    case INT_VAR_REGRET_MIN_MAX: return "regret_minmax";
+    case INT_VAR_REGRET_MAX_MIN: return "regret_maxmin";
+    case INT_VAR_REGRET_MAX_MAX: return "regret_max";
+    default: return "?";
+    }
+}
+
+/// Statistics of \a d at the minimal frequency of \a opt
+Planner::Planner(const Options_fimcp& opt, const Dataset& d) :
+    data(d), density(0), nr_freq(0), skew(0) {
+    int freq = opt.getFreq(data.nr_t);
+    double sum = 0, sum2 = 0;
+    for (int i=0; i!=data.nr_i; i++) {
+        int supp = 0;
+        for (int t=0; t!=data.nr_t; t++)
+            supp += data.tdb[t][i];
+        if (supp >= freq) {
+            nr_freq++;
+            sum += supp;
+            sum2 += (double)supp*supp;
+        }
+    }
+    if (nr_freq != 0 && sum != 0) {
+        density = sum/((double)nr_freq*data.nr_t);
+        double mean = sum/nr_freq;
+        double var = sum2/nr_freq - mean*mean;
+        skew = sqrt(var > 0 ? var : 0)/mean;
+    }
+}
+
+/// Engine for \a opt
+int Planner::engine(const Options_fimcp& opt, int native) {
+    if (native == ENGINE_CP)
+        return ENGINE_CP;
+    // what only Gecode does
+    if (opt.output() == OUT_CPVARS || opt.mode() != SM_SOLUTION)
+        return ENGINE_CP;
+    if (opt.given("-threads") || opt.given("-cclause") || opt.given("-branching") ||
+        opt.given("-branchval") || opt.given("-c-d") || opt.given("-a-d") ||
+        opt.given("-batch") || opt.given("-shape") || opt.given("-trace"))
+        return ENGINE_CP;
+    // the search limits of the Gecode driver
+    if (opt.given("-time") || opt.given("-node") || opt.given("-fail"))
+        return ENGINE_CP;
+    // only Eclat of the native engines checkpoints
+    if (opt.given("-checkpoint") && native != ENGINE_ECLAT)
+        return ENGINE_CP;
+    return native;
+}
+
+/// Vertical representation for the native engine
+int Planner::vertical(void) const {
+    // sparse: the diffsets are hardly ever shorter than the tidsets
+    return (density < 0.5 ? (int)VERT_TIDSET : (int)VERT_AUTO);
+}
+
+/// Branching for the CP engine
+int Planner::branching(void) const {
+    return (skew < 0.1 ? (int)INT_VAR_NONE : (int)INT_VAR_DEGREE_MAX);
+}
+
+/// Fill in the options not given in \a opt
+void Planner::plan(Options_fimcp& opt, int native) {
+    // -engine auto, also without -plan
+    bool chosen = (opt.engine() == ENGINE_AUTO);
+    if (chosen)
+        opt.engine(engine(opt, native));
+    if (!opt.plan())
+        return;
+    const Dataset& data = Dataset::get(opt.datafile());
+    Planner p(opt, data);
+
+    fprintf(stdout, " plan (density %.2f, %i frequent items, support skew %.2f):",
+            p.density, p.nr_freq, p.skew);
+    fprintf(stdout, " engine %s%s", engine_names[opt.engine()],
+            (chosen ? " (auto)" : opt.given("-engine") ? " (given)" : ""));
+
+    if (opt.engine() == ENGINE_ECLAT) {
+        if (!opt.given("-vertical"))
+            opt.vertical(p.vertical());
+        fprintf(stdout, ", vertical %s%s", vertical_names[opt.vertical()],
+                (opt.given("-vertical") ? " (given)" : ""));
+    } else if (opt.engine() == ENGINE_CP) {
+        if (!opt.given("-branching"))
+            opt.branching(p.branching());
+        fprintf(stdout, ", branching %s%s", branching_name(opt.branching()),
+                (opt.given("-branching") ? " (given)" : ""));
+    }
+    fprintf(stdout, "\n");
+}
+
+#endif
@@ -0,0 +1,82 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_PLANNER_HH__
+#define __FIMCP_COMMON_PLANNER_HH__
+
+#include "fimcp_basic.hh"
+
+/**
+ * \brief Chooses the options that were not given, from dataset statistics
+ *
+ * Every model calls Planner::plan() after parsing its options. The
+ * planner looks at the dataset and fills in what the user left open:
+ *  - engine, with -engine auto only (the default stays cp): the native
+ *    engine of the model (if any), unless the output, search mode,
+ *    search limits (-time, -node, -fail) or CP options given ask for
+ *    Gecode
+ *  - vertical (native engine): tidsets if the frequent items are sparse,
+ *    automatic tidset/diffset switching if they are dense
+ *  - branching (CP): input order if the item supports are uniform (all
+ *    degrees tie, computing them is wasted), max degree otherwise
+ *
+ * The plan is printed, options given on the command line are kept and
+ * -plan 0 turns planning off.
+ *
+ */
+class Planner {
+protected:
+  /// the dataset
+  const Dataset& data;
+  /// fraction of ones in the columns of the frequent items
+  double density;
+  /// nr of frequent items
+  int nr_freq;
+  /// coefficient of variation of the supports of the frequent items
+  double skew;
+public:
+  /// Statistics of \a data at the minimal frequency of \a opt
+  Planner(const Options_fimcp& opt, const Dataset& data);
+
+  /// Engine for \a opt, for a model that \a native can solve (ENGINE_CP if none)
+  static int engine(const Options_fimcp& opt, int native);
+  /// Vertical representation for the native engine
+  int vertical(void) const;
+  /// Branching for the CP engine
+  int branching(void) const;
+
+  /// Fill in the options not given in \a opt for a model that \a native can solve
+  static void plan(Options_fimcp& opt, int native);
+};
+
+#endif
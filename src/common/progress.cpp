@@ -0,0 +1,116 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_PROGRESS__
+#define __FIMCP_COMMON_PROGRESS__
+
+#include "progress.hh"
+#include "phases.hh"
+
+#include <cstdio>
+#include <thread>
+
+bool Progress::on = false;
+bool Progress::exact = true;
+unsigned int Progress::interval = 0;
+chrono::steady_clock::time_point Progress::started;
+atomic<unsigned int> Progress::tick(0);
+atomic<unsigned long> Progress::sols(0);
+atomic<unsigned long> Progress::nodes(0);
+atomic<int> Progress::depth(-1);
+atomic<long> Progress::done(-1);
+
+/// Fixed point unit of Progress::done
+static const double DONE_ONE = (double)(1L<<30);
+
+void Progress::enable(unsigned int seconds) {
+    if (on || seconds == 0)
+        return;
+    on = true;
+    interval = seconds;
+    started = chrono::steady_clock::now();
+    thread(timer).detach();
+}
+
+void Progress::approximate(void) {
+    exact = false;
+}
+
+void Progress::disable(void) {
+    on = false;
+}
+
+void Progress::sample(unsigned long n, int d, double f) {
+    nodes.fetch_add(n, memory_order_relaxed);
+    depth.store(d, memory_order_relaxed);
+    done.store((f < 0 ? -1 : (long)(f*DONE_ONE)), memory_order_relaxed);
+}
+
+void Progress::timer(void) {
+    unsigned long nodes_before = 0;
+    double before = 0;
+    while (true) {
+        this_thread::sleep_for(chrono::seconds(interval));
+        if (!on)
+            return;
+        // the search threads sample at their next clone or candidate
+        tick.fetch_add(1, memory_order_relaxed);
+        this_thread::sleep_for(chrono::milliseconds(20));
+        if (!on)
+            return;
+        double now = chrono::duration_cast<chrono::milliseconds>(
+            chrono::steady_clock::now() - started).count() / 1000.0;
+        unsigned long n = nodes.load(memory_order_relaxed);
+        char line[256];
+        int len = snprintf(line, sizeof(line), " progress %.0fs: %lu solutions",
+                           now, sols.load(memory_order_relaxed));
+        if (exact)
+            len += snprintf(line+len, sizeof(line)-len, ", %.0f nodes/s",
+                            (now > before ? (n - nodes_before)/(now - before) : 0));
+        nodes_before = n;
+        before = now;
+        int d = depth.load(memory_order_relaxed);
+        long f = done.load(memory_order_relaxed);
+        if (exact && d >= 0)
+            len += snprintf(line+len, sizeof(line)-len, ", depth %i", d);
+        len += snprintf(line+len, sizeof(line)-len, ", %ld MB", (Phases::rss()+512)/1024);
+        if (exact && f > 0) {
+            double frac = f / DONE_ONE;
+            len += snprintf(line+len, sizeof(line)-len, ", %.1f%% done, eta %.0fs",
+                            100*frac, now*(1-frac)/frac);
+        }
+        fprintf(stderr, "%s\n", line);
+    }
+}
+
+#endif
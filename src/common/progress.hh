@@ -0,0 +1,111 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_PROGRESS_HH__
+#define __FIMCP_COMMON_PROGRESS_HH__
+
+#include <atomic>
+#include <chrono>
+using namespace std;
+
+/**
+ * \brief Live progress of a search (-progress)
+ *
+ * With -progress <seconds> a timer thread prints a line on stderr every
+ * interval, eg
+ *   progress 60s: 123456 solutions, 850123 nodes/s, depth 14, 312 MB, 37.5% done, eta 100s
+ *
+ * The search is not checked at every node: the timer only bumps a tick.
+ * A search thread compares the tick with the last one it saw when it
+ * clones a space (CP) or expands a candidate (native engines), and only
+ * when it changed it publishes its nodes, depth and the fraction of the
+ * search tree it completed with sample().
+ *
+ * The fraction done is an estimate from the path to the current node,
+ * mostly decided by the top-level branching: for the binary CP search
+ * the sum of 1/2^(d+1) over the decisions d on the path that took the
+ * second alternative, for the native engines the candidates done at
+ * every depth, a candidate weighing as much as the candidates it can
+ * still be extended with (see Fimcp_native::progress_sample). The CP
+ * counts assume a clone at every branching (-c-d 0 or 1, the default),
+ * one thread and the DFS of Gecode (not Budget_search, ie no -membudget
+ * or -checkpoint); otherwise the line has no nodes, depth and eta.
+ *
+ */
+class Progress {
+public:
+  /// Print a progress line every \a seconds
+  static void enable(unsigned int seconds);
+  /// The nodes, depth and fraction done of the samples are not exact
+  /// (CP search with -c-d > 1, several threads or Budget_search): only
+  /// print the rest
+  static void approximate(void);
+  /// Stop printing (the search ended)
+  static void disable(void);
+  /// Printing progress?
+  static bool enabled(void) { return on; }
+
+  /// Did the timer tick since \a seen (updated)?
+  static bool due(unsigned int& seen) {
+    unsigned int t = tick.load(memory_order_relaxed);
+    if (t == seen)
+      return false;
+    seen = t;
+    return true;
+  }
+  /// A solution was found
+  static void solution(void) {
+    if (on)
+      sols.fetch_add(1, memory_order_relaxed);
+  }
+  /// Publish the state of a search thread: \a nodes since its last
+  /// sample, its \a depth and the fraction \a done of its tree
+  static void sample(unsigned long nodes, int depth, double done);
+
+protected:
+  static bool on;
+  static bool exact;
+  static unsigned int interval;
+  static chrono::steady_clock::time_point started;
+  static atomic<unsigned int> tick;
+  static atomic<unsigned long> sols;
+  static atomic<unsigned long> nodes;
+  /// of the last sample, done in 1/2^30
+  static atomic<int> depth;
+  static atomic<long> done;
+
+  /// The timer thread
+  static void timer(void);
+};
+
+#endif
@@ -61,8 +61,8 @@ template <class Type>
 void Reader_Eliz<Type>::read ( string filename ) {
     FILE *in = fopen(filename.c_str(),"rt");
     if (!in) {
-        fprintf(stderr, "\tError: file %s does not exist !\n", filename.c_str());
-        exit(1);
+        this->fail("file " + filename + " does not exist");
+        return;
     }
     // first pass, read data to know nr of items and nr of trans
     int nr_i = 0;
@@ -86,6 +86,10 @@ void Reader_Eliz<Type>::read ( string filename ) {
             }
         }
     } while (!feof(in));
+    if (this->error != "") {
+        fclose(in);
+        return;
+    }
 
     //std::cerr << "Nr items is: "<<nr_i<<"\n";
     //std::cerr << "Nr trans is: "<<nr_t<<"\n";
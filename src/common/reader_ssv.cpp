@@ -50,10 +50,14 @@ template <class Type>
 class Reader_SSV {
   public:
     vector <vector<Type> > data;
+    /// why the file could not be read (tolerant readers only)
+    string error;
 
-    Reader_SSV () { }
+    Reader_SSV () : tolerant(false) { }
     ~Reader_SSV () { }
     virtual void read ( string filename );
+    /// Report errors in \a error instead of exiting (see Server)
+    void tolerate_errors ( void ) { tolerant = true; }
 
     inline bool is_space ( char pos ) {
         return pos == ' ' || pos == '\n' || pos == '\t' || pos == ',' || pos == '\r';
@@ -61,14 +65,28 @@ class Reader_SSV {
 
     /// parse integer, c is first char, rest is in *in, space separated
     inline int parse_int(char &c, FILE *in);
+  protected:
+    bool tolerant;
+    /// Report \a msg, the first one only if tolerant, else exit
+    void fail ( const string& msg );
 };
 
+template <class Type>
+void Reader_SSV<Type>::fail ( const string& msg ) {
+    if (!tolerant) {
+        fprintf(stderr, "\tError: %s !\n", msg.c_str());
+        exit(1);
+    }
+    if (error == "")
+        error = msg;
+}
+
 template <class Type>
 void Reader_SSV<Type>::read ( string filename ) {
     FILE *in = fopen(filename.c_str(),"rt");
     if (!in) {
-        std::cerr << "\tError: file "<<filename<<" does not exist !"<<std::endl;
-        exit(1);
+        fail("file " + filename + " does not exist");
+        return;
     }
 
     do {
@@ -107,8 +125,11 @@ int Reader_SSV<Type>::parse_int(char &c, FILE *in) {
     do {
         cval = int(c)-int('0');
         if (cval < 0 || cval > 9) {
-            fprintf(stderr, "\tError: unexpected input, non-digit '%c'=%i found !\n", c, cval);
-            exit(1);
+            char msg[64];
+            snprintf(msg, sizeof(msg), "unexpected input, non-digit '%c'=%i found", c, cval);
+            fail(msg);
+            c = '\n'; // skip the rest of the line
+            return val;
         }
         val *= 10;
         val += cval;
@@ -0,0 +1,269 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_RESULTSTORE__
+#define __FIMCP_COMMON_RESULTSTORE__
+
+#include "result_store.hh"
+
+#include <cerrno>
+#include <sys/stat.h>
+
+static void store_error(const char* msg, const string& file) {
+    fprintf(stderr, "\tError: %s %s !\n", msg, file.c_str());
+    exit(1);
+}
+
+/// Read a varint from \a in, false on end of file
+static bool get_varint(FILE* in, unsigned int& v) {
+    v = 0;
+    int c;
+    for (int shift = 0; (c = getc(in)) != EOF; shift += 7) {
+        if (shift > 28)
+            return false;
+        v |= (unsigned int)(c & 0x7f) << shift;
+        if ((c & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+/// Store for the query \a opt, \a labels if the model uses class labels
+ResultStore::ResultStore(Options_fimcp& o, bool l) :
+    opt(o), labels(l), style(Fimcp_basic::print_style(o)), kept(PRINT_BINARY),
+    nr_i(0), nr_t(0), minsup(0), stored(-1), teefile(NULL), tee(NULL) {
+    if (strcmp(opt.store(),"") == 0)
+        return;
+    if (style == PRINT_NONE || style == PRINT_CPVARS) {
+        fprintf(stderr, "\tError: -store needs the solutions, not -output none or cpvars !\n");
+        exit(1);
+    }
+    if (strcmp(opt.batch(),"") != 0) {
+        fprintf(stderr, "\tError: -store can not be combined with -batch !\n");
+        exit(1);
+    }
+
+    const Dataset& data = Dataset::get(opt.datafile());
+    nr_i = data.nr_i;
+    nr_t = data.nr_t;
+    minsup = opt.getFreq(labels ? data.nr_pos() : nr_t);
+    if (style == PRINT_FULL || style == PRINT_BINFULL)
+        kept = PRINT_BINFULL;
+
+    // the key, and its hash for the file name
+    char buf[32];
+    model = opt.name();
+    snprintf(buf, sizeof(buf), "%016llx", data.fingerprint());
+    dataset = buf;
+    params = opt.constraint_params() + (kept == PRINT_BINFULL ? " tids=1" : " tids=0");
+    string key = model + "\n" + dataset + "\n" + params;
+    unsigned long long h = 14695981039346656037ULL;
+    for (unsigned int k=0; k!=key.size(); k++)
+        h = (h ^ (unsigned char)key[k]) * 1099511628211ULL;
+    snprintf(buf, sizeof(buf), "%016llx", h);
+
+    if (mkdir(opt.store(), 0777) != 0 && errno != EEXIST)
+        store_error("can not create store directory", opt.store());
+    path = string(opt.store()) + "/" + model + "-" + buf;
+    read_meta();
+}
+
+/// Read the text file of the entry, false if there is none for this key
+bool ResultStore::read_meta(void) {
+    FILE* f = fopen((path+".txt").c_str(), "r");
+    if (f == NULL)
+        return false;
+    char line[2048];
+    string m, d, p;
+    int s = -1;
+    while (fgets(line, sizeof(line), f) != NULL) {
+        string l(line);
+        if (l.size() != 0 && l[l.size()-1] == '\n')
+            l.resize(l.size()-1);
+        size_t sp = l.find(' ');
+        if (sp == string::npos)
+            continue;
+        string k = l.substr(0, sp);
+        if (k == "model") m = l.substr(sp+1);
+        else if (k == "dataset") d = l.substr(sp+1);
+        else if (k == "params") p = l.substr(sp+1);
+        else if (k == "minsup") s = atoi(l.c_str()+sp+1);
+    }
+    fclose(f);
+    // a hash collision is just a miss, the entry gets overwritten
+    if (m != model || d != dataset || p != params || s < 0)
+        return false;
+    stored = s;
+    return true;
+}
+
+/// Write the text file of the entry, for minimal support \a s
+void ResultStore::write_meta(int s) const {
+    FILE* f = fopen((path+".txt").c_str(), "w");
+    if (f == NULL)
+        store_error("can not write", path+".txt");
+    fprintf(f, "model %s\ndataset %s\nparams %s\nminsup %i\n",
+            model.c_str(), dataset.c_str(), params.c_str(), s);
+    fclose(f);
+}
+
+/// Put the stored solutions with support >= \a from to \a w, returns how many
+unsigned long ResultStore::replay(int from, SolutionWriter* w) const {
+    string file = path + ".bin";
+    FILE* in = fopen(file.c_str(), "rb");
+    if (in == NULL)
+        store_error("can not open", file);
+    char magic[sizeof(BIN_MAGIC)];
+    unsigned int n_i, n_t;
+    if (fread(magic, 1, strlen(BIN_MAGIC), in) != strlen(BIN_MAGIC) ||
+        strncmp(magic, BIN_MAGIC, strlen(BIN_MAGIC)) != 0 ||
+        getc(in) != BIN_VERSION)
+        store_error("not a stored result:", file);
+    int flags = getc(in);
+    if (!get_varint(in, n_i) || !get_varint(in, n_t) ||
+        (int)n_i != nr_i || (int)n_t != nr_t ||
+        ((flags & BIN_LABELS) != 0) != labels || ((flags & BIN_TIDS) != 0) != (kept == PRINT_BINFULL))
+        store_error("stored result does not match its key:", file);
+
+    vector<int>& items = w->scratch_items();
+    vector<int>& tids = w->scratch_tids();
+    unsigned long count = 0;
+    unsigned int n;
+    while (get_varint(in, n)) {
+        bool ok = true;
+        unsigned int v, pos, neg = 0;
+        items.clear();
+        for (unsigned int k=0; k!=n && (ok = get_varint(in, v)); k++)
+            items.push_back((k == 0 ? 0 : items.back()+1) + v);
+        ok = ok && get_varint(in, pos);
+        if (labels)
+            ok = ok && get_varint(in, neg);
+        tids.clear();
+        if (ok && (flags & BIN_TIDS)) {
+            int kind = getc(in);
+            if (kind == BIN_TIDS_RANGES) {
+                unsigned int r, start, len, end = 0;
+                ok = get_varint(in, r);
+                for (unsigned int k=0; ok && k!=r; k++) {
+                    ok = get_varint(in, start) && get_varint(in, len);
+                    start += end;
+                    end = start + len + 1;
+                    for (unsigned int t=start; t!=end; t++)
+                        tids.push_back(t);
+                }
+            } else if (kind == BIN_TIDS_BITMAP) {
+                for (int byte=0; ok && byte != (nr_t+7)/8; byte++) {
+                    int c = getc(in);
+                    ok = (c != EOF);
+                    for (int b=0; b!=8; b++)
+                        if (c & (1 << b))
+                            tids.push_back(byte*8+b);
+                }
+            } else {
+                ok = false;
+            }
+        }
+        if (!ok)
+            store_error("corrupt stored result", file);
+        if ((int)pos >= from) {
+            w->put_solution(style, items, labels, pos, neg, tids, nr_t);
+            count++;
+        }
+    }
+    fclose(in);
+    return count;
+}
+
+/// Answer the query from the store, false if a search is still needed
+bool ResultStore::serve(void) {
+    if (path == "")
+        return false;
+    Support::Timer t;
+    t.start();
+    SolutionWriter* w = Fimcp_basic::solution_writer(opt);
+    if (stored != -1 && minsup >= stored) {
+        // stricter (or same) threshold: filter the stored solutions
+        fprintf(stdout, "%s\n", opt.name());
+        Dataset::get(opt.datafile()).print_info(opt.datafile(), minsup);
+        w->put_header(style, labels, nr_i, nr_t);
+        unsigned long n = replay(minsup, w);
+        fprintf(stdout, " store: %lu solutions from %s.bin (minsup %i) in %.3f ms, no search\n",
+                n, path.c_str(), stored, t.stop());
+        return true;
+    }
+    if (opt.solutions() != 0 || opt.given("-time") || opt.given("-node") || opt.given("-fail")) {
+        // an incomplete result can not be stored
+        fprintf(stdout, " Warning: -store ignored, the search is limited.\n");
+        path = "";
+        return false;
+    }
+
+    // search, and keep everything it finds in the new entry
+    teefile = fopen((path+".new").c_str(), "wb");
+    if (teefile == NULL)
+        store_error("can not write", path+".new");
+    tee = new SolutionWriter(teefile);
+    tee->put_header(kept, labels, nr_i, nr_t);
+    w->tee(tee, kept);
+    if (stored != -1) {
+        // looser threshold: the supports >= stored are in the store
+        opt.supp_below(stored);
+        fprintf(stdout, " store: minsup %i stored, searching supports in [%i,%i)\n",
+                stored, minsup, stored);
+    }
+    return false;
+}
+
+/// After the search: add the stored solutions and update the entry
+void ResultStore::finish(void) {
+    if (tee == NULL)
+        return;
+    SolutionWriter* w = Fimcp_basic::solution_writer(opt);
+    unsigned long n = 0;
+    if (stored != -1)
+        n = replay(0, w); // also goes to the new entry
+    w->tee(NULL, PRINT_NONE);
+    delete tee;
+    tee = NULL;
+    fclose(teefile);
+    if (rename((path+".new").c_str(), (path+".bin").c_str()) != 0)
+        store_error("can not write", path+".bin");
+    write_meta(minsup);
+    if (stored != -1)
+        fprintf(stdout, " store: %lu stored solutions added, kept at minsup %i in %s.bin\n",
+                n, minsup, path.c_str());
+    else
+        fprintf(stdout, " store: kept at minsup %i in %s.bin\n", minsup, path.c_str());
+}
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_RESULTSTORE_HH__
+#define __FIMCP_COMMON_RESULTSTORE_HH__
+
+#include "fimcp_basic.hh"
+
+/**
+ * \brief Keeps mined results to answer later queries with another -freq
+ *
+ * The solutions at minimal support s contain the solutions at every
+ * s' > s. With -store dir, every result is kept in dir, keyed on the
+ * model, a hash of the dataset and the other options that change the
+ * solutions (Options_fimcp::constraint_params). A later query on the
+ * same key:
+ *  - with s' >= s: is answered from the store, without search
+ *  - with s' < s: only searches the supports in [s', s) and adds the
+ *    stored solutions; the store then keeps the result at s'
+ *
+ * For models with class labels the support is that of the positive
+ * transactions, on which -freq is put. This does not hold for models
+ * where the threshold changes more than the support range (maximal
+ * itemsets), they do not use a store.
+ *
+ * An entry is dir/<model>-<key>.bin, in the binary output format (see
+ * binary_format.hh, fimcp_decode prints it), and a text file
+ * dir/<model>-<key>.txt with its key and minimal support.
+ *
+ */
+class ResultStore {
+protected:
+  /// the options of the query
+  Options_fimcp& opt;
+  /// path of the entry without extension, "" without -store
+  string path;
+  /// key of the entry
+  string model, dataset, params;
+  /// supports are split in pos/neg?
+  bool labels;
+  /// output style of the query and of the entry
+  PrintStyle style, kept;
+  /// size of the dataset
+  int nr_i, nr_t;
+  /// minimal support of the query, and of the entry (-1: none)
+  int minsup, stored;
+  /// writer of the new entry, if searching
+  FILE* teefile;
+  SolutionWriter* tee;
+
+  /// Read the text file of the entry, false if there is none for this key
+  bool read_meta(void);
+  /// Write the text file of the entry, for minimal support \a s
+  void write_meta(int s) const;
+  /// Put the stored solutions with support >= \a from to \a w, returns how many
+  unsigned long replay(int from, SolutionWriter* w) const;
+public:
+  /// Store for the query \a opt, \a labels if the model uses class labels
+  ResultStore(Options_fimcp& opt, bool labels);
+  /// Answer the query from the store, false if a search is still needed
+  bool serve(void);
+  /// After the search: add the stored solutions and update the entry
+  void finish(void);
+};
+
+#endif
@@ -0,0 +1,227 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_SERVER__
+#define __FIMCP_COMMON_SERVER__
+
+#include "server.hh"
+#include "fimcp_blocks.hh"
+
+#include <algorithm>
+#include <csignal>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/// Name of the model served
+static string served;
+/// Connections waiting for a worker
+static std::deque<int> pending;
+static std::mutex pending_lock;
+static std::condition_variable pending_cond;
+
+/// Worker: answer waiting connections, forever
+static void work(Server::OptionsFn options, Server::SolveFn solve,
+                 void (*handle)(int, Server::OptionsFn, Server::SolveFn)) {
+    while (true) {
+        int fd;
+        {
+            std::unique_lock<std::mutex> lock(pending_lock);
+            while (pending.empty())
+                pending_cond.wait(lock);
+            fd = pending.front();
+            pending.pop_front();
+        }
+        handle(fd, options, solve);
+    }
+}
+
+/// Why the request \a opt can not be mined ("" if it can): its model,
+/// dataset and attributes are checked here, the readers would exit
+static string check(const Options_fimcp& opt) {
+    string spec = Fimcp_blocks::spec(opt);
+    string error;
+    if (!Fimcp_blocks::valid(spec.c_str(), error))
+        return error;
+    const Fimcp_blocks model(spec.c_str());
+    const Dataset* data = Dataset::find(opt.datafile(), error);
+    if (data == NULL)
+        return error;
+    if (model.labels() && data->classes.size() == 0)
+        return string("no class labels found in ") + opt.datafile();
+    if (model.attributes()) {
+        Reader_SSV<int> attr;
+        attr.tolerate_errors();
+        attr.read(opt.attrfile());
+        if (attr.error != "")
+            return attr.error;
+        if (attr.data.size() == 0 || attr.data[0].size() < (size_t)data->nr_i)
+            return string("no cost for every item in ") + opt.attrfile();
+    }
+    return "";
+}
+
+/// Serve requests on the socket of \a opt, forever
+int Server::run(const Options_fimcp& opt, OptionsFn options, SolveFn solve) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(opt.serve()) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "\tError: socket name %s is too long !\n", opt.serve());
+        return 1;
+    }
+    strcpy(addr.sun_path, opt.serve());
+
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(opt.serve());
+    if (sock < 0 || bind(sock, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        listen(sock, 64) != 0) {
+        fprintf(stderr, "\tError: can not listen on %s !\n", opt.serve());
+        return 1;
+    }
+    // clients that go away must not end the server
+    signal(SIGPIPE, SIG_IGN);
+    served = opt.name();
+
+    unsigned int n = (opt.workers() == 0 ? 1 : opt.workers());
+    for (unsigned int k=0; k!=n; k++)
+        std::thread(work, options, solve, handle).detach();
+    fprintf(stdout, "%s: serving on %s with %u workers\n", opt.name(), opt.serve(), n);
+    fflush(stdout);
+
+    while (true) {
+        int fd = accept(sock, NULL, NULL);
+        if (fd < 0)
+            continue;
+        std::lock_guard<std::mutex> lock(pending_lock);
+        pending.push_back(fd);
+        pending_cond.notify_one();
+    }
+    return 0;
+}
+
+/// Answer the request on connection \a fd
+void Server::handle(int fd, OptionsFn options, SolveFn solve) {
+    // the request line
+    string line;
+    char c;
+    while (read(fd, &c, 1) == 1 && c != '\n')
+        line += c;
+    FILE* f = fdopen(fd, "w");
+    if (f == NULL) {
+        close(fd);
+        return;
+    }
+
+    vector<string> words;
+    for (size_t k = 0; k < line.size(); ) {
+        size_t e = line.find_first_of(" \t\r", k);
+        if (e == string::npos)
+            e = line.size();
+        if (e != k)
+            words.push_back(line.substr(k, e-k));
+        k = e+1;
+    }
+
+    // the options of the request, as the model's main sets them
+    string error;
+    Options_fimcp opt(words.size() == 0 ? "" : words[0].c_str());
+    options(opt);
+    opt.request(true);
+    vector<char*> argv;
+    for (unsigned int k=0; k!=words.size(); k++)
+        argv.push_back((char*)words[k].c_str());
+    argv.push_back(NULL);
+    int argc = argv.size()-1;
+    size_t slash = (words.size() == 0 ? 0 : words[0].find_last_of("/\\"));
+    if (words.size() == 0) {
+        error = "empty request";
+    } else if (words[0].substr(slash == string::npos ? 0 : slash+1) != served) {
+        error = "this server only serves " + served;
+    } else if (find(words.begin(), words.end(), "-help") != words.end() ||
+               find(words.begin(), words.end(), "-serve") != words.end() ||
+               find(words.begin(), words.end(), "-workers") != words.end() ||
+               find(words.begin(), words.end(), "-timing") != words.end() ||
+               find(words.begin(), words.end(), "-progress") != words.end() ||
+               find(words.begin(), words.end(), "-shape") != words.end() ||
+               find(words.begin(), words.end(), "-trace") != words.end() ||
+               find(words.begin(), words.end(), "-checkpoint") != words.end()) {
+        error = "-help, -serve, -workers, -timing, -progress, -shape, -trace and -checkpoint can not be requested";
+    } else {
+        opt.parse(argc, &argv[0]);
+        if (strcmp(opt.batch(),"") != 0 || strcmp(opt.store(),"") != 0 || opt.hybrid() != 0 ||
+            opt.profile() != 0 || opt.membudget() != 0)
+            error = "-batch, -store, -hybrid, -profile and -membudget can not be requested";
+        else if (Fimcp_basic::print_style(opt) == PRINT_CPVARS)
+            error = "-output cpvars can not be requested";
+        else if (argc > 1)
+            error = string("unknown option ") + argv[1];
+        else
+            error = check(opt);
+    }
+    fprintf(stdout, "request: %s%s%s\n", line.c_str(),
+            (error == "" ? "" : ", error: "), error.c_str());
+
+    if (error == "") {
+        Support::Timer t;
+        t.start();
+        PrintStyle style = Fimcp_basic::print_style(opt);
+        SolutionWriter w(f);
+        w.tolerate_errors();
+        Fimcp_basic::serving(&w);
+        try {
+            if (solve(opt) != 0)
+                error = "the model failed, see the log";
+        } catch (Exception& e) {
+            error = e.what();
+        } catch (std::exception& e) {
+            error = e.what();
+        }
+        Fimcp_basic::serving(NULL);
+        if (error == "" && style != PRINT_BINARY && style != PRINT_BINFULL) {
+            char end[64];
+            snprintf(end, sizeof(end), "@end %.3f ms\n", t.stop());
+            w.put(end, strlen(end));
+        }
+        w.close();
+    }
+    if (error != "")
+        fprintf(f, "@error %s\n", error.c_str());
+    fclose(f);
+    fflush(stdout);
+}
+
+#endif
@@ -0,0 +1,73 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_SERVER_HH__
+#define __FIMCP_COMMON_SERVER_HH__
+
+#include "fimcp_basic.hh"
+
+/**
+ * \brief Serves mining requests on a unix socket (-serve)
+ *
+ * Datasets stay in memory between requests (see Dataset::get), so a
+ * request does not pay for reading and parsing its dataset again.
+ *
+ * Every connection is one request: a single line with the name of the
+ * model followed by its options, as on the command line, eg
+ *   fimcp_closed -datafile ../data/chess.txt -freq 0.8 -output binary
+ * The answer is what -solfile would contain, followed by a line
+ * "@end <milliseconds> ms" for the text outputs. A request that fails
+ * gets a line "@error <reason>". The connection is then closed. The
+ * model, dataset and attribute file of a request are checked before it
+ * is mined, so that a bad request does not end the server.
+ *
+ * -workers requests are served at the same time, others wait. A binary
+ * serves its own model only. -batch, -store and -hybrid do not apply
+ * to requests, the statistics of every request go to the log (stdout).
+ *
+ */
+class Server {
+public:
+  /// Sets the options of a model to their defaults
+  typedef void (*OptionsFn)(Options_fimcp&);
+  /// Mines the parsed options, returns the exit code
+  typedef int (*SolveFn)(Options_fimcp&);
+
+  /// Serve requests on the socket of \a opt, forever
+  static int run(const Options_fimcp& opt, OptionsFn options, SolveFn solve);
+protected:
+  /// Answer the request on connection \a fd
+  static void handle(int fd, OptionsFn options, SolveFn solve);
+};
+
+#endif
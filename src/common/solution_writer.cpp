@@ -0,0 +1,347 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_SOLUTIONWRITER__
+#define __FIMCP_COMMON_SOLUTIONWRITER__
+
+#include "solution_writer.hh"
+
+#include <cstdlib>
+#include <chrono>
+#include <unistd.h>
+
+SolutionWriter::SolutionWriter(FILE* f, bool e, size_t size, unsigned int n)
+  : out(f), buf(NULL), pos(0), cap(size), eager(e), tolerant(false), _failed(false), _resumed(false),
+    nr_blocks(n), blocks(NULL), lens(NULL),
+    head(0), tail(0), done(false), writer(NULL), stalls(0),
+    _tee(NULL), _tee_style(PRINT_NONE) {
+  if (nr_blocks == 0) {
+    buf = (char*)malloc(cap);
+    if (buf == NULL) {
+      fprintf(stderr, "\tError: can not allocate output buffer !\n");
+      exit(1);
+    }
+  } else {
+    blocks = (char**)malloc(nr_blocks*sizeof(char*));
+    lens = (size_t*)malloc(nr_blocks*sizeof(size_t));
+    if (blocks == NULL || lens == NULL) {
+      fprintf(stderr, "\tError: can not allocate output buffer !\n");
+      exit(1);
+    }
+    for (unsigned int i=0; i!=nr_blocks; i++) {
+      blocks[i] = (char*)malloc(cap);
+      if (blocks[i] == NULL) {
+        fprintf(stderr, "\tError: can not allocate output buffer !\n");
+        exit(1);
+      }
+    }
+    buf = blocks[0];
+    writer = new std::thread(&SolutionWriter::drain, this);
+  }
+}
+
+SolutionWriter::~SolutionWriter(void) {
+  close();
+  if (nr_blocks == 0) {
+    free(buf);
+  } else {
+    for (unsigned int i=0; i!=nr_blocks; i++)
+      free(blocks[i]);
+    free(blocks);
+    free(lens);
+  }
+}
+
+void
+SolutionWriter::flush(void) {
+  if (pos == 0)
+    return;
+  if (nr_blocks == 0) {
+    if (!failed() && fwrite(buf, 1, pos, out) != pos)
+      _failed.store(true, std::memory_order_release);
+    pos = 0;
+    check();
+    return;
+  }
+
+  // hand the current buffer to the writer thread
+  unsigned long h = head.load(std::memory_order_relaxed);
+  lens[h % nr_blocks] = pos;
+  head.store(++h, std::memory_order_release);
+  // the next buffer must have been written out before we reuse it
+  if (h - tail.load(std::memory_order_acquire) == nr_blocks) {
+    stalls++;
+    while (h - tail.load(std::memory_order_acquire) == nr_blocks)
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+  }
+  buf = blocks[h % nr_blocks];
+  pos = 0;
+  check();
+}
+
+void
+SolutionWriter::check(void) {
+  if (!failed() || tolerant)
+    return;
+  // the writer thread only sets the flag: exiting there would run
+  // close() at exit, which joins that same thread
+  tolerant = true; // close() at exit drops the rest
+  fprintf(stderr, "\tError: can not write solutions !\n");
+  exit(1);
+}
+
+void
+SolutionWriter::put_header(PrintStyle s, bool labels, int nr_i, int nr_t) {
+  if (_resumed)
+    return;
+  if (s == PRINT_BINARY || s == PRINT_BINFULL) {
+    // binary output, see binary_format.hh
+    char flags = 0;
+    if (labels)
+      flags |= BIN_LABELS;
+    if (s == PRINT_BINFULL)
+      flags |= BIN_TIDS;
+    put(BIN_MAGIC, strlen(BIN_MAGIC));
+    put((char)BIN_VERSION);
+    put(flags);
+    put_varint(nr_i);
+    put_varint(nr_t);
+    end_solution();
+  } else if (s == PRINT_DELTA) {
+    // mark the output as delta encoded ('@' lines are comments)
+    put("@delta\n", 7);
+    end_solution();
+  }
+}
+
+void
+SolutionWriter::put_solution(PrintStyle s, const vector<int>& items, bool labels,
+                             int pos, int neg, const vector<int>& tids, int nr_t) {
+  if (_tee != NULL)
+    _tee->put_solution(_tee_style, items, labels, pos, neg, tids, nr_t);
+  if (s == PRINT_BINARY || s == PRINT_BINFULL) {
+    // binary output, see binary_format.hh
+    put_varint(items.size());
+    int prev = -1;
+    for (unsigned int k=0; k!=items.size(); k++) {
+      put_varint(items[k]-prev-1);
+      prev = items[k];
+    }
+    put_varint(pos);
+    if (labels)
+      put_varint(neg);
+    if (s == PRINT_BINFULL)
+      put_tidset(tids, nr_t);
+    end_solution();
+    return;
+  }
+
+  if (s == PRINT_DELTA) {
+    // delta on the previous solution: pop n, push items
+    put_delta(items);
+    put(' ');
+  } else {
+    // FIMI style output
+    for (unsigned int k=0; k!=items.size(); k++) {
+      put_uint(items[k]);
+      put(' ');
+    }
+  }
+  put('(');
+  if (!labels) {
+    put_uint(pos);
+  } else {
+    put_uint(pos+neg);
+    put(":+", 2);
+    put_uint(pos);
+    put('-');
+    put_uint(neg);
+  }
+  put(')');
+  if (s == PRINT_FULL) {
+    // FULL output, items and transactions
+    put(" <", 2);
+    for (unsigned int k=0; k!=tids.size(); k++) {
+      put(' ');
+      put_uint(tids[k]);
+    }
+    put(" >", 2);
+  }
+  put('\n');
+  end_solution();
+}
+
+void
+SolutionWriter::put_tidset(const vector<int>& tids, int nr_t) {
+  // size when written as ranges
+  unsigned int nr_ranges = 0;
+  size_t bytes = 0;
+  int end = 0;
+  for (unsigned int k=0; k!=tids.size(); ) {
+    unsigned int start = k;
+    while (k+1 != tids.size() && tids[k+1] == tids[k]+1)
+      k++;
+    k++;
+    unsigned int v[2] = { (unsigned int)(tids[start] - end), k - start - 1 };
+    for (int j=0; j!=2; j++) {
+      bytes++;
+      for (unsigned int x = v[j]; x >= 0x80; x >>= 7)
+        bytes++;
+    }
+    end = tids[k-1] + 1;
+    nr_ranges++;
+  }
+
+  if (bytes < (size_t)(nr_t+7)/8) {
+    put((char)BIN_TIDS_RANGES);
+    put_varint(nr_ranges);
+    end = 0;
+    for (unsigned int k=0; k!=tids.size(); ) {
+      unsigned int start = k;
+      while (k+1 != tids.size() && tids[k+1] == tids[k]+1)
+        k++;
+      k++;
+      put_varint(tids[start] - end);
+      put_varint(k - start - 1);
+      end = tids[k-1] + 1;
+    }
+  } else {
+    put((char)BIN_TIDS_BITMAP);
+    unsigned int k = 0;
+    for (int byte=0; byte != (nr_t+7)/8; byte++) {
+      unsigned char c = 0;
+      for (; k != tids.size() && tids[k] < (byte+1)*8; k++)
+        c |= (unsigned char)(1 << (tids[k] % 8));
+      put((char)c);
+    }
+  }
+}
+
+void
+SolutionWriter::put_delta(const vector<int>& ids) {
+  if (ids.size() != 0 && _member.size() <= (unsigned int)ids.back()) {
+    _member.resize(ids.back()+1, 0);
+    _instack.resize(ids.back()+1, 0);
+  }
+  for (unsigned int k=0; k!=ids.size(); k++)
+    _member[ids[k]] = 1;
+
+  // keep the bottom of the stack that is still in, pop the rest
+  unsigned int keep = 0;
+  while (keep != _stack.size() && _member[_stack[keep]])
+    keep++;
+  put_uint(_stack.size() - keep);
+  for (unsigned int k=keep; k!=_stack.size(); k++)
+    _instack[_stack[k]] = 0;
+  _stack.resize(keep);
+
+  // push the new ones
+  for (unsigned int k=0; k!=ids.size(); k++) {
+    int i = ids[k];
+    if (!_instack[i]) {
+      put(' ');
+      put_uint(i);
+      _instack[i] = 1;
+      _stack.push_back(i);
+    }
+    _member[i] = 0;
+  }
+}
+
+void
+SolutionWriter::close(void) {
+  flush();
+  if (writer != NULL) {
+    done.store(true, std::memory_order_release);
+    writer->join();
+    delete writer;
+    writer = NULL;
+  }
+  check();
+  fflush(out);
+}
+
+long
+SolutionWriter::sync(void) {
+  flush();
+  while (writer != NULL && tail.load(std::memory_order_acquire) != head.load(std::memory_order_acquire))
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  check();
+  fflush(out);
+  return ftell(out);
+}
+
+void
+SolutionWriter::resume(long offset, const vector<int>& stack) {
+  fflush(out);
+  if (ftruncate(fileno(out), offset) != 0 || fseek(out, offset, SEEK_SET) != 0) {
+    fprintf(stderr, "\tError: can not continue the solutions file at byte %ld !\n", offset);
+    exit(1);
+  }
+  _stack = stack;
+  for (unsigned int k=0; k!=_stack.size(); k++) {
+    if (_instack.size() <= (unsigned int)_stack[k]) {
+      _instack.resize(_stack[k]+1, 0);
+      _member.resize(_stack[k]+1, 0);
+    }
+    _instack[_stack[k]] = 1;
+  }
+  _resumed = true;
+}
+
+const vector<int>&
+SolutionWriter::delta_stack(void) const {
+  return _stack;
+}
+
+void
+SolutionWriter::drain(void) {
+  unsigned long t = tail.load(std::memory_order_relaxed);
+  while (true) {
+    if (t == head.load(std::memory_order_acquire)) {
+      // nothing to write: stop if that is final, else wait a bit
+      if (done.load(std::memory_order_acquire) &&
+          t == head.load(std::memory_order_acquire))
+        break;
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      continue;
+    }
+    unsigned int i = t % nr_blocks;
+    // on an error only set the flag, the search thread reports it
+    if (!failed() && fwrite(blocks[i], 1, lens[i], out) != lens[i])
+      _failed.store(true, std::memory_order_release);
+    tail.store(++t, std::memory_order_release);
+  }
+}
+
+#endif
@@ -0,0 +1,269 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_SOLUTIONWRITER_HH__
+#define __FIMCP_COMMON_SOLUTIONWRITER_HH__
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <atomic>
+#include <thread>
+using namespace std;
+
+#include "binary_format.hh"
+
+enum PrintStyle {
+    PRINT_NONE,
+    PRINT_FIMI,
+    PRINT_FULL,
+    PRINT_CPVARS,
+    PRINT_BINARY,
+    PRINT_BINFULL,
+    PRINT_DELTA
+};
+
+/**
+ * \brief Buffered solution writer
+ *
+ * Formats solutions into one large reusable buffer (hand-rolled
+ * integer conversion, no printf) and writes it out with big fwrite
+ * calls. The writer is shared by all clones of a space.
+ *
+ * With a ring of \a n buffers, full buffers are handed to a separate
+ * writer thread instead (single producer, single consumer, lock-free),
+ * so the search only waits for I/O when all buffers are full.
+ *
+ */
+class SolutionWriter {
+protected:
+  FILE* out;     ///< file to write to
+  char* buf;     ///< output buffer
+  size_t pos;    ///< current position in buf
+  size_t cap;    ///< size of buf
+  bool eager;    ///< flush after every solution
+  bool tolerant; ///< a write error stops the output, not the program
+  std::atomic<bool> _failed; ///< a write error happened (set by the writer thread too)
+  bool _resumed; ///< continues a file, that has its header
+
+  // ring of buffers for the writer thread (if nr_blocks != 0)
+  unsigned int nr_blocks;           ///< number of buffers in the ring
+  char** blocks;                    ///< the buffers
+  size_t* lens;                     ///< bytes used in every buffer
+  std::atomic<unsigned long> head;  ///< buffers handed over (producer)
+  std::atomic<unsigned long> tail;  ///< buffers written (consumer)
+  std::atomic<bool> done;           ///< no more buffers will come
+  std::thread* writer;              ///< the writer thread
+  unsigned long stalls;             ///< times the ring was full
+
+  /// scratch space for the callers, reused between solutions
+  vector<int> _items, _tids;
+  /// writer that gets a copy of every solution (if not NULL), in style _tee_style
+  SolutionWriter* _tee;
+  PrintStyle _tee_style;
+  /// items of the previous solution, in push order (delta output)
+  vector<int> _stack;
+  /// per item: in _stack / in the current solution (delta output)
+  vector<char> _instack, _member;
+
+  /// Write out the buffers of the ring (writer thread)
+  void drain(void);
+  /// Exit on a write error, unless tolerant (search thread)
+  void check(void);
+public:
+  /// Initialize for file \a f with buffer size \a size
+  /// if \a e then the buffer is flushed after every solution
+  /// if \a n > 0 then a writer thread with a ring of \a n buffers is used
+  SolutionWriter(FILE* f, bool e = false, size_t size = 1<<20, unsigned int n = 0);
+  /// Destructor, closes
+  ~SolutionWriter(void);
+
+  /// Write a single character
+  void put(char c);
+  /// Write \a n characters of \a s
+  void put(const char* s, size_t n);
+  /// Write unsigned integer \a v in decimal
+  void put_uint(unsigned int v);
+  /// Write unsigned integer \a v as varint (binary output)
+  void put_varint(unsigned int v);
+  /// Write the sorted transaction ids \a tids out of \a nr_t (binary output)
+  void put_tidset(const vector<int>& tids, int nr_t);
+  /// Write the sorted item ids \a ids as delta on the previous call:
+  /// nr of items to pop, then the items to push (delta output)
+  void put_delta(const vector<int>& ids);
+  /// Write the header of the output in style \a s, if any
+  void put_header(PrintStyle s, bool labels, int nr_i, int nr_t);
+  /// Write a solution in style \a s: the sorted \a items, the support
+  /// \a pos (\a pos and \a neg if \a labels) and the sorted \a tids
+  /// out of \a nr_t (only used by the full styles)
+  void put_solution(PrintStyle s, const vector<int>& items, bool labels,
+                    int pos, int neg, const vector<int>& tids, int nr_t);
+  /// Drop the output after a write error (eg a client that went away)
+  /// instead of exiting, see failed()
+  void tolerate_errors(void);
+  /// Did a write fail? (tolerant writers only)
+  bool failed(void) const;
+  /// Also write every solution to \a w, in style \a s (NULL: stop)
+  void tee(SolutionWriter* w, PrintStyle s);
+  /// Scratch vectors for the items and tids of a solution
+  vector<int>& scratch_items(void);
+  vector<int>& scratch_tids(void);
+  /// The file written to
+  FILE* file(void) const;
+  /// End of a solution
+  void end_solution(void);
+  /// Write the buffer to the file (or hand it to the writer thread)
+  void flush(void);
+  /// Flush and wait for the writer thread to finish
+  void close(void);
+  /// Write out everything so far (also the ring), the size of the file
+  long sync(void);
+  /// Continue the file after its first \a offset bytes (dropping the
+  /// rest), the last solution there had items \a stack in push order
+  /// (delta output); see Checkpoint
+  void resume(long offset, const vector<int>& stack);
+  /// Items of the last solution, in push order (delta output)
+  const vector<int>& delta_stack(void) const;
+  /// Number of buffers that went through the ring
+  unsigned long ring_buffers(void) const;
+  /// Number of times the search had to wait for a full ring
+  unsigned long ring_stalls(void) const;
+};
+
+inline void
+SolutionWriter::put(char c) {
+  if (pos == cap)
+    flush();
+  buf[pos++] = c;
+}
+
+inline void
+SolutionWriter::put(const char* s, size_t n) {
+  while (cap - pos < n) {
+    // fill up and flush, the ring needs whole buffers
+    size_t k = cap - pos;
+    memcpy(buf+pos, s, k);
+    pos += k; s += k; n -= k;
+    flush();
+  }
+  memcpy(buf+pos, s, n);
+  pos += n;
+}
+
+inline void
+SolutionWriter::put_uint(unsigned int v) {
+  static const char digits[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+  // at most 10 digits
+  if (cap - pos < 10)
+    flush();
+  // count digits
+  size_t len = 1;
+  for (unsigned int x = v; x >= 10; x /= 10)
+    len++;
+  // fill backwards, two digits at a time
+  char* p = buf + pos + len;
+  while (v >= 100) {
+    unsigned int d = (v % 100) * 2;
+    v /= 100;
+    *--p = digits[d+1];
+    *--p = digits[d];
+  }
+  if (v >= 10) {
+    *--p = digits[v*2+1];
+    *--p = digits[v*2];
+  } else {
+    *--p = (char)('0' + v);
+  }
+  pos += len;
+}
+
+inline void
+SolutionWriter::put_varint(unsigned int v) {
+  // at most 5 bytes
+  if (cap - pos < 5)
+    flush();
+  while (v >= 0x80) {
+    buf[pos++] = (char)((v & 0x7f) | 0x80);
+    v >>= 7;
+  }
+  buf[pos++] = (char)v;
+}
+
+inline vector<int>&
+SolutionWriter::scratch_items(void) {
+  return _items;
+}
+inline vector<int>&
+SolutionWriter::scratch_tids(void) {
+  return _tids;
+}
+inline void
+SolutionWriter::tolerate_errors(void) {
+  tolerant = true;
+}
+inline bool
+SolutionWriter::failed(void) const {
+  return _failed.load(std::memory_order_acquire);
+}
+
+inline void
+SolutionWriter::tee(SolutionWriter* w, PrintStyle s) {
+  _tee = w;
+  _tee_style = s;
+}
+inline FILE*
+SolutionWriter::file(void) const {
+  return out;
+}
+
+inline unsigned long
+SolutionWriter::ring_buffers(void) const {
+  return head.load();
+}
+inline unsigned long
+SolutionWriter::ring_stalls(void) const {
+  return stalls;
+}
+
+inline void
+SolutionWriter::end_solution(void) {
+  if (eager)
+    flush();
+}
+
+#endif
@@ -0,0 +1,112 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_TIDSET_HH__
+#define __FIMCP_COMMON_TIDSET_HH__
+
+#include <vector>
+using namespace std;
+
+/**
+ * Bitset helpers for the native (vertical) engines:
+ * a tidset is an array of words, tid t is bit (t%WORD_BITS) of word (t/WORD_BITS)
+ */
+typedef unsigned long word_t;
+#define WORD_BITS (8*sizeof(word_t))
+
+/// Number of words for \a n bits
+inline int tidset_words(int n) {
+    return (n + WORD_BITS - 1) / WORD_BITS;
+}
+
+/// Number of bits set in \a w
+inline int popcount(word_t w) {
+#ifdef __GNUC__
+    return __builtin_popcountl(w);
+#else
+    int c = 0;
+    for (; w != 0; w &= w-1)
+        c++;
+    return c;
+#endif
+}
+
+/// Index of the lowest bit set in \a w (not 0)
+inline int lowest_bit(word_t w) {
+#ifdef __GNUC__
+    return __builtin_ctzl(w);
+#else
+    int b = 0;
+    while (!((w >> b) & 1))
+        b++;
+    return b;
+#endif
+}
+
+/// \a dst = \a a AND \a b (\a n words), returns the nr of bits set
+inline int tidset_and(word_t* dst, const word_t* a, const word_t* b, int n) {
+    int c = 0;
+    for (int k=0; k!=n; k++) {
+        dst[k] = a[k] & b[k];
+        c += popcount(dst[k]);
+    }
+    return c;
+}
+
+/// Nr of bits set in \a a AND \a b (\a n words)
+inline int tidset_and_count(const word_t* a, const word_t* b, int n) {
+    int c = 0;
+    for (int k=0; k!=n; k++)
+        c += popcount(a[k] & b[k]);
+    return c;
+}
+
+/// Append the tids in \a a and not in \a b (\a n words) to \a tids, returns their nr
+inline int tidset_andnot_list(const word_t* a, const word_t* b, int n, vector<int>& tids) {
+    int c = tids.size();
+    for (int k=0; k!=n; k++) {
+        for (word_t w = a[k] & ~b[k]; w != 0; w &= w-1)
+            tids.push_back(k*WORD_BITS + lowest_bit(w));
+    }
+    return tids.size() - c;
+}
+
+/// Append the tids in \a a (\a n words) to \a tids
+inline void tidset_list(const word_t* a, int n, vector<int>& tids) {
+    for (int k=0; k!=n; k++) {
+        for (word_t w = a[k]; w != 0; w &= w-1)
+            tids.push_back(k*WORD_BITS + lowest_bit(w));
+    }
+}
+
+#endif
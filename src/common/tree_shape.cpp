@@ -0,0 +1,138 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_TREE_SHAPE__
+#define __FIMCP_COMMON_TREE_SHAPE__
+
+#include "tree_shape.hh"
+
+#include <cstring>
+
+/// Names of the space status, as in the trace
+static const char* const status_names[] = {"failed", "solved", "branch"};
+
+Tree_shape::Tree_shape(unsigned long m, FILE* t, unsigned long s) :
+    nodes(0), sols(0), max_sols(m), trace(t), sample(s) {}
+
+void Tree_shape::node(Fimcp_basic* s, unsigned long parent, int depth, unsigned int alt) {
+    unsigned long id = nodes++;
+    SpaceStatus status = s->status();
+    int unfixed = 0, covered = 0;
+    if (status != SS_FAILED)
+        s->shape(unfixed, covered);
+
+    if ((int)depths.size() <= depth)
+        depths.resize(depth+1);
+    Depth& d = depths[depth];
+    d.nodes++;
+    d.unfixed += unfixed;
+    d.covered += covered;
+    if (status == SS_FAILED)
+        d.fails++;
+    else if (status == SS_SOLVED)
+        d.sols++;
+    if (trace != NULL && id % sample == 0)
+        fprintf(trace, "{\"id\":%lu,\"parent\":%ld,\"depth\":%i,\"alt\":%u,\"status\":\"%s\",\"unfixed\":%i,\"covered\":%i}\n",
+                id, (id == 0 ? -1L : (long)parent), depth, alt, status_names[status], unfixed, covered);
+
+    if (status == SS_SOLVED) {
+        sols++;
+    } else if (status == SS_BRANCH) {
+        // the alternatives of the model's own branching, the last one
+        // on this space itself
+        const Choice* c = s->choice();
+        unsigned int n = c->alternatives();
+        for (unsigned int a=0; a!=n && (max_sols == 0 || sols < max_sols); a++) {
+            Fimcp_basic* child = (a+1 == n ? s : static_cast<Fimcp_basic*>(s->clone()));
+            child->commit(*c, a);
+            node(child, id, depth+1, a);
+            if (child != s)
+                delete child;
+        }
+        delete c;
+    }
+}
+
+void Tree_shape::print(const Options_fimcp& opt, const char* file) const {
+    unsigned long fails = 0;
+    for (unsigned int k=0; k!=depths.size(); k++)
+        fails += depths[k].fails;
+
+    if (strcmp(file, "-") == 0 || strcmp(file, "") == 0) {
+        fprintf(stdout, " shape: %lu nodes, %lu failures, %lu solutions, depth %lu\n",
+                nodes, fails, sols, (unsigned long)depths.size()-1);
+        for (unsigned int k=0; k!=depths.size(); k++) {
+            const Depth& d = depths[k];
+            fprintf(stdout, "\tdepth %3u: %10lu nodes %10lu failures %10lu solutions %8.1f unfixed items %10.1f covered transactions\n",
+                    k, d.nodes, d.fails, d.sols, d.unfixed/d.nodes, d.covered/d.nodes);
+        }
+        return;
+    }
+
+    FILE* f = fopen(file, "w");
+    if (f == NULL) {
+        fprintf(stderr, "\tError: can not open %s !\n", file);
+        exit(1);
+    }
+    fprintf(f, "{\"model\": \"%s\", \"datafile\": \"%s\", \"nodes\": %lu, \"failures\": %lu, \"solutions\": %lu, \"depths\": [",
+            opt.name(), opt.datafile(), nodes, fails, sols);
+    for (unsigned int k=0; k!=depths.size(); k++) {
+        const Depth& d = depths[k];
+        fprintf(f, "%s\n  {\"depth\": %u, \"nodes\": %lu, \"failures\": %lu, \"solutions\": %lu, \"unfixed\": %.2f, \"covered\": %.2f}",
+                (k == 0 ? "" : ","), k, d.nodes, d.fails, d.sols, d.unfixed/d.nodes, d.covered/d.nodes);
+    }
+    fprintf(f, "\n]}\n");
+    fclose(f);
+    fprintf(stdout, " shape: %lu nodes, %lu failures, %lu solutions, written to %s\n",
+            nodes, fails, sols, file);
+}
+
+void Tree_shape::run(const Options_fimcp& opt) {
+    FILE* trace = NULL;
+    if (strcmp(opt.trace(), "") != 0) {
+        trace = fopen(opt.trace(), "w");
+        if (trace == NULL) {
+            fprintf(stderr, "\tError: can not open %s !\n", opt.trace());
+            exit(1);
+        }
+    }
+    Tree_shape shape(opt.solutions(), trace, (opt.tracesample() == 0 ? 1 : opt.tracesample()));
+    Fimcp_basic* root = new Fimcp_basic(opt);
+    shape.node(root, 0, 0, 0);
+    delete root;
+    if (trace != NULL)
+        fclose(trace);
+    shape.print(opt, opt.shape());
+}
+
+#endif
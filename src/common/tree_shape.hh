@@ -0,0 +1,93 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#ifndef __FIMCP_COMMON_TREE_SHAPE_HH__
+#define __FIMCP_COMMON_TREE_SHAPE_HH__
+
+#include <cstdio>
+#include <vector>
+using namespace std;
+
+#include "fimcp_basic.hh"
+
+/**
+ * \brief Shape of the search tree of a model (-shape, -trace)
+ *
+ * Without Gist, to see why a -branching/-branchval combination explodes
+ * on a dataset: the model is searched depth-first with its own
+ * branching (Space::choice and commit, a clone per alternative), and
+ * for every depth the shape counts
+ *  - nodes, failures and solutions
+ *  - the average nr of unassigned items
+ *  - the average nr of covered transactions (not assigned to 0)
+ *
+ * -shape - prints the table, -shape <file> writes it as JSON to <file>.
+ * -trace <file> writes one in every -tracesample nodes (in depth-first
+ * order) as a line of JSON: its number, the number of its parent, depth,
+ * alternative, status and the same counts, eg
+ *   {"id":200,"parent":198,"depth":7,"alt":1,"status":"failed","unfixed":31,"covered":12}
+ *
+ * Solutions are counted, not printed.
+ */
+class Tree_shape {
+protected:
+  /// counts of one depth
+  struct Depth {
+    unsigned long nodes;
+    unsigned long fails;
+    unsigned long sols;
+    double unfixed;
+    double covered;
+    Depth(void) : nodes(0), fails(0), sols(0), unfixed(0), covered(0) {}
+  };
+  vector<Depth> depths;
+  unsigned long nodes;
+  unsigned long sols;
+  /// stop after this many solutions (0: all)
+  unsigned long max_sols;
+  /// trace file (NULL: none) and its sample rate
+  FILE* trace;
+  unsigned long sample;
+
+  Tree_shape(unsigned long max_sols, FILE* trace, unsigned long sample);
+  /// Search below \a s, child \a alt of node \a parent at \a depth
+  void node(Fimcp_basic* s, unsigned long parent, int depth, unsigned int alt);
+  /// Print the table, or write it as JSON to \a file
+  void print(const Options_fimcp& opt, const char* file) const;
+
+public:
+  /// Search the model of \a opt and print or write its shape
+  static void run(const Options_fimcp& opt);
+};
+
+#endif
@@ -0,0 +1,175 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#include "common/fimcp_basic.hh"
+#include "common/fimcp_blocks.hh"
+#include "common/planner.hh"
+#include "common/batch.hh"
+#include "common/server.hh"
+#include "common/approximate.hh"
+#include "common/result_store.hh"
+#include "common/fimcp_eclat.hh"
+#include "common/fimcp_lcm.hh"
+#include "common/block_profile.hh"
+
+/// Nr of blocks run() posts, all if -1 (see Block_profile)
+static int stage_blocks = -1;
+
+/**
+ * All models in one binary: the constraint blocks named by -model.
+ * implements Fimcp_basic::run.
+ */
+void Fimcp_basic::run(const Options_fimcp& opt) {
+    const Fimcp_blocks model(opt.model());
+    const vector< vector<bool> > tdb = model_construction(opt, model.labels());
+    Block_home home(*this, items, transactions, tdb, classes);
+
+    if (stage_blocks != -1) {
+        // a stage of Block_profile: its blocks, no search
+        for (int k=0; k!=stage_blocks; k++)
+            model.post_block(k, home, opt);
+        return;
+    }
+
+    // shared by all settings of a batch
+    if (posting_base())
+        model.post_base(home, opt);
+
+    if (!posting_setting())
+        return; // the base of a batch, see Batch
+
+    model.post_setting(home, opt);
+    post_search(opt, home, model.linear());
+}
+
+
+/// The first \a blocks blocks of the model of \a opt
+static Fimcp_basic* profile_stage(const Options_fimcp& opt, int blocks) {
+    stage_blocks = blocks;
+    Fimcp_basic* s = new Fimcp_basic(opt);
+    stage_blocks = -1;
+    return s;
+}
+
+
+static void model_options(Options_fimcp& opt) {
+    opt.datafile("../data/example.txt");
+    opt.attrfile("../data/example.attr");
+    opt.model("standard");
+    opt.freq(0.10);
+    opt.infreq(0.10);
+    opt.delta(0.80);
+    opt.bound1_op(IRT_GQ);
+    opt.bound1_val(0);
+    opt.bound2_op(IRT_LQ);
+    opt.bound2_val(999000);
+    opt.engine(ENGINE_CP);
+    opt.vertical(VERT_AUTO);
+    opt.hybrid(0);
+    opt.profile(0);
+    opt.batch("");
+    opt.store("");
+    opt.description("This binary finds the patterns of any combination of constraint blocks: standard, closed, deltaclosed, maximal, discriminating, emerging, size, cost, avgcost");
+    opt.usage("-model closed+cost -datafile example.txt -freq 0.10 -attrfile example.attr -bound1 LQ 500\n \
+              \tthe blocks are those of the fimcp_* binaries, with the same options\n \
+              \tdelta is the delta-closedness or, with emerging, the minimal growth rate\n \
+              \tthe first of size, cost and avgcost uses bound1, the second bound2");
+}
+
+/// Mine the (parsed) options \a opt
+static int model_solve(Options_fimcp& opt) {
+    const Fimcp_blocks model(opt.model());
+    int native = ENGINE_CP;
+    if (opt.profile())
+        native = ENGINE_CP; // profiles the CP blocks
+    else if (strcmp(model.name(),"standard") == 0)
+        native = ENGINE_ECLAT;
+    else if (strcmp(model.name(),"closed") == 0)
+        native = ENGINE_LCM;
+    Planner::plan(opt, native);
+    fprintf(stdout, " model %s (%s)\n", model.name(),
+            (model.compiled() ? "compiled" : "composed at runtime"));
+
+    if (opt.profile()) {
+        if (opt.engine() != ENGINE_CP || strcmp(opt.batch(),"") != 0 ||
+            strcmp(opt.store(),"") != 0 || opt.hybrid()) {
+            fprintf(stderr, "\tError: -profile needs -engine cp, without -batch, -store or -hybrid !\n");
+            return 1;
+        }
+        opt.output(OUT_NONE);
+        vector<string> names;
+        for (int k=0; k!=model.size(); k++)
+            names.push_back(model.block(k));
+        Block_profile::run(opt, names, profile_stage);
+        return 0;
+    }
+
+    if (model.maximal() && strcmp(opt.store(),"") != 0) {
+        fprintf(stderr, "\tError: -store does not support maximal !\n");
+        return 1;
+    }
+    ResultStore store(opt, model.labels());
+    if (store.serve())
+        return 0;
+
+    if (opt.engine() == ENGINE_ECLAT && native == ENGINE_ECLAT) {
+        Fimcp_native::solve<Fimcp_eclat>(opt, "eclat");
+    } else if (opt.engine() == ENGINE_LCM && native == ENGINE_LCM) {
+        Fimcp_native::solve<Fimcp_lcm>(opt, "lcm");
+    } else if (opt.engine() == ENGINE_CP && strcmp(opt.batch(),"") != 0) {
+        Batch::run(opt);
+    } else if (opt.engine() == ENGINE_CP) {
+        Fimcp_basic::solve(opt);
+    } else {
+        fprintf(stderr, "\tError: engine not supported by -model %s, use cp !\n", model.name());
+        return 1;
+    }
+    store.finish();
+    return 0;
+}
+
+
+int main(int argc, char* argv[]) {
+    Options_fimcp opt(strpbrk(argv[0],"/\\")+1);
+    model_options(opt);
+    opt.serve("");
+    opt.workers(4);
+    opt.approx(0);
+    opt.parse(argc, argv);
+
+    if (strcmp(opt.serve(),"") != 0)
+        return Server::run(opt, model_options, model_solve);
+    if (opt.approx() != 0)
+        return Approximate::run(opt, model_solve);
+    return model_solve(opt);
+}
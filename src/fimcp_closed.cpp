@@ -33,80 +33,68 @@
  */
 
 #include "common/fimcp_basic.hh"
+#include "common/fimcp_blocks.hh"
+#include "common/planner.hh"
+#include "common/batch.hh"
+#include "common/server.hh"
+#include "common/approximate.hh"
+#include "common/result_store.hh"
+#include "common/fimcp_lcm.hh"
 
 /**
  * Closed frequent itemset mining.
  * implements Fimcp_basic::run.
  */
 void Fimcp_basic::run(const Options_fimcp& opt) {
-    const vector< vector<bool> > tdb = common_construction(opt);
-    if (classes.size() != 0) {
-        classes.resize(0);
-        fprintf(stdout, " Warning: class labels found, ignored.\n");
-    }
+    post_model<Closed_model>(opt);
+}
 
-    /** covered constraints **/
-    if (opt.cclause()) {
-        // Default! Clause is a bit faster and uses less memory
-        coverage_clause(tdb);
-    } else {
-        IntArgs row_(nr_i);
-        for (int t=0; t!=nr_t; t++) {
-            // make 1-row
-            for (int i=0; i!=nr_i; i++)
-                row_[i] = (1-tdb[t][i]);
 
-            // coverage: the trans its complement has no supported items
-            // sum((1-row(trans_t))*Items) = 0 <=> trans_t
-            linear(*this, row_, items, IRT_EQ, 0, transactions[t]);
-        }
-    }
+/// The options of this model, with their defaults
+static void model_options(Options_fimcp& opt) {
+    opt.datafile("../data/example.txt");
+    opt.freq(0.10);
+    opt.engine(ENGINE_CP);
+    opt.batch("");
+    opt.store("");
+    opt.description("This model finds closed frequent patterns (no pattern has a superset with the same frequency)");
+    opt.usage("-datafile example.txt -freq 0.10");
+}
 
-    /** closed constraints **/
-    {
-        IntArgs col_(nr_t);
-        for (int i=0; i!=nr_i; i++) {
-            // make 1-col
-            for (int t=0; t!=nr_t; t++)
-                col_[t] = (1-tdb[t][i]);
+/// Mine the (parsed) options \a opt
+static int model_solve(Options_fimcp& opt) {
+    Planner::plan(opt, ENGINE_LCM);
 
-            // closed: the item its complement has no supported trans
-            // sum((1-col(item_i))*Trans) = 0 <=> item_i
-            linear(*this, col_, transactions, IRT_EQ, 0, items[i]);
-        }
-    }
+    ResultStore store(opt, false);
+    if (store.serve())
+        return 0;
 
-    /** frequency constraints **/
-    {
-        int freq = opt.getFreq(nr_t);
-        IntArgs col(nr_t);
-        for (int i=0; i!=nr_i; i++) {
-            // make col
-            for (int t=0; t!=nr_t; t++)
-                col[t] = tdb[t][i];
-
-            // freq: the item is supported by sufficiently many trans
-            BoolVar aux(*this, 0, 1); // auxiliary variable
-            // sum(col(item_i)*Trans) >= Freq <=> aux
-            linear(*this, col, transactions, IRT_GQ, freq, aux);
-            // item_i => aux :: item_i =< aux
-            rel(*this, items[i], IRT_LQ, aux);
-        }
+    if (opt.engine() == ENGINE_LCM) {
+        Fimcp_native::solve<Fimcp_lcm>(opt, "lcm");
+    } else if (opt.engine() == ENGINE_CP && strcmp(opt.batch(),"") != 0) {
+        Batch::run(opt);
+    } else if (opt.engine() == ENGINE_CP) {
+        Fimcp_basic::solve(opt);
+    } else {
+        fprintf(stderr, "\tError: engine not supported by %s, use cp or lcm !\n", opt.name());
+        return 1;
     }
-
-    /** search **/
-    branch(*this, items, (IntVarBranch)opt.branching(), (IntValBranch)opt.branchval());
+    store.finish();
+    return 0;
 }
 
 
 int main(int argc, char* argv[]) {
     Options_fimcp opt(strpbrk(argv[0],"/\\")+1);
-    opt.datafile("../data/example.txt");
-    opt.freq(0.10);
-    opt.description("This model finds closed frequent patterns (no pattern has a superset with the same frequency)");
-    opt.usage("-datafile example.txt -freq 0.10");
+    model_options(opt);
+    opt.serve("");
+    opt.workers(4);
+    opt.approx(0);
     opt.parse(argc, argv);
 
-    Script::run<Fimcp_basic,DFS,Options_fimcp>(opt);
-    return 0;
+    if (strcmp(opt.serve(),"") != 0)
+        return Server::run(opt, model_options, model_solve);
+    if (opt.approx() != 0)
+        return Approximate::run(opt, model_solve);
+    return model_solve(opt);
 }
@@ -33,85 +33,62 @@
  */
 
 #include "common/fimcp_basic.hh"
-
-#define PRECISION 1000 // 3 numbers after comma
+#include "common/fimcp_blocks.hh"
+#include "common/planner.hh"
+#include "common/batch.hh"
+#include "common/server.hh"
+#include "common/approximate.hh"
+#include "common/result_store.hh"
 
 /**
  * Delta-closed frequent itemset mining.
  * implements Fimcp_basic::run.
  */
 void Fimcp_basic::run(const Options_fimcp& opt) {
-    const vector< vector<bool> > tdb = common_construction(opt);
-    if (classes.size() != 0) {
-        classes.resize(0);
-        fprintf(stdout, " Warning: class labels found, ignored.\n");
-    }
-
-    /** covered constraints **/
-    if (opt.cclause()) {
-        // Default! Clause is a bit faster and uses less memory
-        coverage_clause(tdb);
-    } else {
-        IntArgs row_(nr_i);
-        for (int t=0; t!=nr_t; t++) {
-            // make 1-row
-            for (int i=0; i!=nr_i; i++)
-                row_[i] = (1-tdb[t][i]);
-
-            // coverage: the trans its complement has no supported items
-            // sum((1-row(trans_t))*Items) = 0 <=> trans_t
-            linear(*this, row_, items, IRT_EQ, 0, transactions[t]);
-        }
-    }
+    post_model<Deltaclosed_model>(opt);
+}
 
-    /** delta-closed constraints **/
-    {
-        int hdelta = (int)(opt.delta()*PRECISION);
-        IntArgs col_delta(nr_t);
-        for (int i=0; i!=nr_i; i++) {
-            // make col_delta: (1-col)*1000 - delta*1000 {precision with 3 numbers after comma}
-            for (int t=0; t!=nr_t; t++)
-                col_delta[t] = ((1-tdb[t][i])*PRECISION) - hdelta;
 
-            // delta-closed: the item its complement has at most a few supported trans
-            // sum( (100*(1-col(item_i))-100*delta)*Trans ) =< 0 <=> item_i
-            linear(*this, col_delta, transactions, IRT_LQ, 0, items[i]);
-        }
-    }
+/// The options of this model, with their defaults
+static void model_options(Options_fimcp& opt) {
+    opt.datafile("../data/example.txt");
+    opt.freq(0.10);
+    opt.delta(0.80);
+    opt.batch("");
+    opt.store("");
+    opt.description("This model finds delta-closed frequent patterns (no pattern has a superset with a frequency higher then `delta` times its frequency)");
+    opt.usage("-datafile example.txt -freq 0.10 -delta 0.80\n \
+              \tdelta has a precision of 3 numbers after the comma");
+}
 
-    /** frequency constraints **/
-    {
-        int freq = opt.getFreq(nr_t);
-        IntArgs col(nr_t);
-        for (int i=0; i!=nr_i; i++) {
-            // make col
-            for (int t=0; t!=nr_t; t++)
-                col[t] = tdb[t][i];
+/// Mine the (parsed) options \a opt
+static int model_solve(Options_fimcp& opt) {
+    Planner::plan(opt, ENGINE_CP);
 
-            // freq: the item is supported by sufficiently many trans
-            BoolVar aux(*this, 0, 1); // auxiliary variable
-            // sum(col(item_i)*Trans) >= Freq <=> aux
-            linear(*this, col, transactions, IRT_GQ, freq, aux);
-            // item_i => aux :: item_i =< aux
-            rel(*this, items[i], IRT_LQ, aux);
-        }
-    }
+    ResultStore store(opt, false);
+    if (store.serve())
+        return 0;
 
-    /** search **/
-    branch(*this, items, (IntVarBranch)opt.branching(), (IntValBranch)opt.branchval());
+    if (strcmp(opt.batch(),"") != 0)
+        Batch::run(opt);
+    else
+        Fimcp_basic::solve(opt);
+    store.finish();
+    return 0;
 }
 
 
 int main(int argc, char* argv[]) {
     Options_fimcp opt(strpbrk(argv[0],"/\\")+1);
-    opt.datafile("../data/example.txt");
-    opt.freq(0.10);
-    opt.delta(0.80);
-    opt.description("This model finds delta-closed frequent patterns (no pattern has a superset with a frequency higher then `delta` times its frequency)");
-    opt.usage("-datafile example.txt -freq 0.10 -delta 0.80\n \
-              \tdelta has a precision of 3 numbers after the comma");
+    model_options(opt);
+    opt.serve("");
+    opt.workers(4);
+    opt.approx(0);
     opt.parse(argc, argv);
 
-    Script::run<Fimcp_basic,DFS,Options_fimcp>(opt);
-    return 0;
+    if (strcmp(opt.serve(),"") != 0)
+        return Server::run(opt, model_options, model_solve);
+    if (opt.approx() != 0)
+        return Approximate::run(opt, model_solve);
+    return model_solve(opt);
 }
@@ -33,88 +33,62 @@
  */
 
 #include "common/fimcp_basic.hh"
+#include "common/fimcp_blocks.hh"
+#include "common/planner.hh"
+#include "common/batch.hh"
+#include "common/server.hh"
+#include "common/approximate.hh"
+#include "common/result_store.hh"
 
 /**
  * Discriminating frequent itemset mining: frequent on one partition, infrequent on the other.
  * implements Fimcp_basic::run.
  */
 void Fimcp_basic::run(const Options_fimcp& opt) {
-    const vector< vector<bool> > tdb = common_construction(opt);
-    if (classes.size() == 0)
-        throw Exception("Class label error", "no class labels found");
-
-    /** covered constraints **/
-    if (opt.cclause()) {
-        // Default! Clause is a bit faster and uses less memory
-        coverage_clause(tdb);
-    } else {
-        IntArgs row_(nr_i);
-        for (int t=0; t!=nr_t; t++) {
-            // make 1-row
-            for (int i=0; i!=nr_i; i++)
-                row_[i] = (1-tdb[t][i]);
-
-            // coverage: the trans its complement has no supported items
-            // sum((1-row(trans_t))*Items) = 0 <=> trans_t
-            linear(*this, row_, items, IRT_EQ, 0, transactions[t]);
-        }
-    }
-
-    // needed for freq and infreq constraints
-    int posTot = 0;
-    for (int t=0; t!=nr_t; t++) {
-        posTot += classes[t];
-        if (classes[t] != 1 && classes[t] != 0)
-            throw Exception("Class label error",
-                "illegal class label found, only '1' (pos) or '0' (neg) allowed");
-    }
-
-    /** frequency constraints, only on pos **/
-    {
-        int freq_pos = opt.getFreq(posTot);
-        IntArgs col_pos(nr_t);
-        for (int i=0; i!=nr_i; i++) {
-            // make col_pos
-            for (int t=0; t!=nr_t; t++)
-                col_pos[t] = tdb[t][i]*classes[t];
+    post_model<Discriminating_model>(opt);
+}
 
-            // freq: the item is supported by sufficiently many trans
-            BoolVar aux(*this, 0, 1); // auxiliary variable
-            // sum(col_pos(item_i)*Trans) >= Freq <=> aux
-            linear(*this, col_pos, transactions, IRT_GQ, freq_pos, aux);
-            // item_i => aux :: item_i =< aux
-            rel(*this, items[i], IRT_LQ, aux);
-        }
-    }
 
-    /** infrequency constraints, only on neg (no gain for reified) **/
-    {
-        int infreq_neg = opt.getInfreq(nr_t-posTot);
+/// The options of this model, with their defaults
+static void model_options(Options_fimcp& opt) {
+    opt.datafile("../data/example.txt");
+    opt.freq(0.10);
+    opt.infreq(0.10);
+    opt.batch("");
+    opt.store("");
+    opt.description("This model finds discriminating frequent patterns (frequent on pos, infrequent on neg)");
+    opt.usage("-datafile example.txt -freq 0.10 -infreq 0.10\n \
+              \tthe datafile needs a class label for every transaction: 1=pos, 0=neg");
+}
 
-        IntArgs col_neg(nr_t);
-        // make col_neg
-        for (int t=0; t!=nr_t; t++)
-            col_neg[t] = (1-classes[t]);
+/// Mine the (parsed) options \a opt
+static int model_solve(Options_fimcp& opt) {
+    Planner::plan(opt, ENGINE_CP);
 
-        // infreq: the item is supported by not more than a few trans
-        linear(*this, col_neg, transactions, IRT_LQ, infreq_neg);
-    }
+    ResultStore store(opt, true);
+    if (store.serve())
+        return 0;
 
-    /** search **/
-    branch(*this, items, (IntVarBranch)opt.branching(), (IntValBranch)opt.branchval());
+    if (strcmp(opt.batch(),"") != 0)
+        Batch::run(opt);
+    else
+        Fimcp_basic::solve(opt);
+    store.finish();
+    return 0;
 }
 
 
 int main(int argc, char* argv[]) {
     Options_fimcp opt(strpbrk(argv[0],"/\\")+1);
-    opt.datafile("../data/example.txt");
-    opt.freq(0.10);
-    opt.infreq(0.10);
-    opt.description("This model finds discriminating frequent patterns (frequent on pos, infrequent on neg)");
-    opt.usage("-datafile example.txt -freq 0.10 -infreq 0.10\n \
-              \tthe datafile needs a class label for every transaction: 1=pos, 0=neg");
+    model_options(opt);
+    opt.serve("");
+    opt.workers(4);
+    opt.approx(0);
     opt.parse(argc, argv);
 
-    Script::run<Fimcp_basic,DFS,Options_fimcp>(opt);
-    return 0;
+    if (strcmp(opt.serve(),"") != 0)
+        return Server::run(opt, model_options, model_solve);
+    if (opt.approx() != 0)
+        return Approximate::run(opt, model_solve);
+    return model_solve(opt);
 }
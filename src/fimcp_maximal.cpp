@@ -33,63 +33,53 @@
  */
 
 #include "common/fimcp_basic.hh"
+#include "common/fimcp_blocks.hh"
+#include "common/planner.hh"
+#include "common/batch.hh"
+#include "common/server.hh"
+#include "common/approximate.hh"
 
 /**
  * Maximal frequent itemset mining.
  * implements Fimcp_basic::run.
  */
 void Fimcp_basic::run(const Options_fimcp& opt) {
-    const vector< vector<bool> > tdb = common_construction(opt);
-    if (classes.size() != 0) {
-        classes.resize(0);
-        fprintf(stdout, " Warning: class labels found, ignored.\n");
-    }
-
-    /** covered constraints **/
-    if (opt.cclause()) {
-        // Default! Clause is a bit faster and uses less memory
-        coverage_clause(tdb);
-    } else {
-        IntArgs row_(nr_i);
-        for (int t=0; t!=nr_t; t++) {
-            // make 1-row
-            for (int i=0; i!=nr_i; i++)
-                row_[i] = (1-tdb[t][i]);
+    post_model<Maximal_model>(opt);
+}
 
-            // coverage: the trans its complement has no supported items
-            // sum((1-row(trans_t))*Items) = 0 <=> trans_t
-            linear(*this, row_, items, IRT_EQ, 0, transactions[t]);
-        }
-    }
 
-    /** frequency+maximal constraints **/
-    {
-        int freq = opt.getFreq(nr_t);
-        IntArgs col(nr_t);
-        for (int i=0; i!=nr_i; i++) {
-            // make col
-            for (int t=0; t!=nr_t; t++)
-                col[t] = tdb[t][i];
+/// The options of this model, with their defaults
+static void model_options(Options_fimcp& opt) {
+    opt.datafile("../data/example.txt");
+    opt.freq(0.10);
+    opt.batch("");
+    opt.description("This model finds maximal frequent patterns (no pattern has a superset that is frequent)");
+    opt.usage("-datafile example.txt -freq 0.10");
+}
 
-            // maximal: the item is supported by sufficiently many trans, and if so then the item itself must be supported
-            // sum(col(i_k)*Trans) >= Freq <=> i_k
-            linear(*this, col, transactions, IRT_GQ, freq, items[i]);
-        }
-    }
+/// Mine the (parsed) options \a opt
+static int model_solve(Options_fimcp& opt) {
+    Planner::plan(opt, ENGINE_CP);
 
-    /** search **/
-    branch(*this, items, (IntVarBranch)opt.branching(), (IntValBranch)opt.branchval());
+    if (strcmp(opt.batch(),"") != 0)
+        Batch::run(opt);
+    else
+        Fimcp_basic::solve(opt);
+    return 0;
 }
 
 
 int main(int argc, char* argv[]) {
     Options_fimcp opt(strpbrk(argv[0],"/\\")+1);
-    opt.datafile("../data/example.txt");
-    opt.freq(0.10);
-    opt.description("This model finds maximal frequent patterns (no pattern has a superset that is frequent)");
-    opt.usage("-datafile example.txt -freq 0.10");
+    model_options(opt);
+    opt.serve("");
+    opt.workers(4);
+    opt.approx(0);
     opt.parse(argc, argv);
 
-    Script::run<Fimcp_basic,DFS,Options_fimcp>(opt);
-    return 0;
+    if (strcmp(opt.serve(),"") != 0)
+        return Server::run(opt, model_options, model_solve);
+    if (opt.approx() != 0)
+        return Approximate::run(opt, model_solve);
+    return model_solve(opt);
 }
@@ -33,6 +33,7 @@
  */
 
 #include "common/fimcp_basic.hh"
+#include "common/planner.hh"
 #include "common/reader_ssv.cpp"
 
 /**
@@ -136,7 +137,8 @@ int main(int argc, char* argv[]) {
               \tthe attrfile has a space separated number for every item: its cost (positive or negative)\n \
               \tbound1 its operator must be LE or LQ to be sensible");
     opt.parse(argc, argv);
+    Planner::plan(opt, ENGINE_CP);
 
-    Script::run<Fimcp_basic,DFS,Options_fimcp>(opt);
+    Fimcp_basic::solve(opt);
     return 0;
 }
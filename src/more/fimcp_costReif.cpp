@@ -33,6 +33,7 @@
  */
 
 #include "common/fimcp_basic.hh"
+#include "common/planner.hh"
 #include "common/reader_ssv.cpp"
 
 /**
@@ -120,7 +121,8 @@ int main(int argc, char* argv[]) {
     opt.usage("-datafile example.txt -freq 0.10 -attrfile example.attr -bound1 GR 20\n \
               \tthe attrfile has a space separated number for every item: its cost (positive or negative)");
     opt.parse(argc, argv);
+    Planner::plan(opt, ENGINE_CP);
 
-    Script::run<Fimcp_basic,DFS,Options_fimcp>(opt);
+    Fimcp_basic::solve(opt);
     return 0;
 }
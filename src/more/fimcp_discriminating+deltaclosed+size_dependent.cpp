@@ -33,6 +33,7 @@
  */
 
 #include "common/fimcp_basic.hh"
+#include "common/planner.hh"
 
 #define PRECISION 1000 // 3 numbers after comma
 
@@ -161,7 +162,8 @@ int main(int argc, char* argv[]) {
               \tbound1 its operator must be GE or GQ to be sensible\n \
               \tbound2 its operator must be LE or LQ to be sensible");
     opt.parse(argc, argv);
+    Planner::plan(opt, ENGINE_CP);
 
-    Script::run<Fimcp_basic,DFS,Options_fimcp>(opt);
+    Fimcp_basic::solve(opt);
     return 0;
 }
@@ -33,6 +33,7 @@
  */
 
 #include "common/fimcp_basic.hh"
+#include "common/planner.hh"
 
 #define PRECISION 1000 // 3 numbers after comma
 
@@ -150,7 +151,8 @@ int main(int argc, char* argv[]) {
               \tdelta has a precision of 3 numbers after the comma\n\
               \tthe datafile needs a class label for every transaction: 1=pos, 0=neg");
     opt.parse(argc, argv);
+    Planner::plan(opt, ENGINE_CP);
 
-    Script::run<Fimcp_basic,DFS,Options_fimcp>(opt);
+    Fimcp_basic::solve(opt);
     return 0;
 }
@@ -33,6 +33,7 @@
  */
 
 #include "common/fimcp_basic.hh"
+#include "common/planner.hh"
 
 /**
  * Maximal frequent itemset mining.
@@ -103,7 +104,8 @@ int main(int argc, char* argv[]) {
     opt.description("This model finds maximal frequent patterns (no pattern has a superset that is frequent), it uses the redundant closed constraint");
     opt.usage("-datafile example.txt -freq 0.10");
     opt.parse(argc, argv);
+    Planner::plan(opt, ENGINE_CP);
 
-    Script::run<Fimcp_basic,DFS,Options_fimcp>(opt);
+    Fimcp_basic::solve(opt);
     return 0;
 }
@@ -33,6 +33,7 @@
  */
 
 #include "common/fimcp_basic.hh"
+#include "common/planner.hh"
 
 /**
  * Standard frequent itemset mining (just minimal frequency).
@@ -82,7 +83,8 @@ int main(int argc, char* argv[]) {
                     \t using a non-reified formulation of the frequency constraint (slower)");
     opt.usage("-datafile example.txt -freq 0.10");
     opt.parse(argc, argv);
+    Planner::plan(opt, ENGINE_CP);
 
-    Script::run<Fimcp_basic,DFS,Options_fimcp>(opt);
+    Fimcp_basic::solve(opt);
     return 0;
 }
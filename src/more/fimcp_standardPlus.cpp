@@ -33,6 +33,7 @@
  */
 
 #include "common/fimcp_basic.hh"
+#include "common/planner.hh"
 #include "common/constraint_linearPlus.hh"
 
 /**
@@ -92,7 +93,8 @@ int main(int argc, char* argv[]) {
     faster then the normal formulation as this one uses a linear implication constraint implemented to avoid auxiliary variables");
     opt.usage("-datafile example.txt -freq 0.10");
     opt.parse(argc, argv);
+    Planner::plan(opt, ENGINE_CP);
 
-    Script::run<Fimcp_basic,DFS,Options_fimcp>(opt);
+    Fimcp_basic::solve(opt);
     return 0;
 }
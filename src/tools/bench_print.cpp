@@ -0,0 +1,174 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+/**
+ * Micro-benchmark of the solution output paths.
+ *
+ * Prints the same random solutions with the original fprintf-per-item
+ * code, with the SolutionWriter and in the binary format, for both the
+ * normal (FIMI) and the full output style.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+using namespace std;
+
+#include "common/solution_writer.hh"
+
+/// One solution: 0/1 per item and per transaction, and the support
+struct Solution {
+    vector<char> items;
+    vector<char> trans;
+    int supp;
+};
+
+static void print_fprintf(FILE* out, const vector<Solution>& sols, bool full) {
+    for (unsigned int s=0; s!=sols.size(); s++) {
+        const Solution& sol = sols[s];
+        for (unsigned int i=0; i!=sol.items.size(); i++) {
+            if (sol.items[i] == 1)
+                fprintf(out, "%i ", i);
+        }
+        if (!full) {
+            fprintf(out, "(%i)\n", sol.supp);
+        } else {
+            fprintf(out, "(%i) < ", sol.supp);
+            for (unsigned int t=0; t!=sol.trans.size(); t++)
+                if (sol.trans[t] == 1)
+                    fprintf(out, "%i ", t);
+            fprintf(out, ">\n");
+        }
+    }
+}
+
+/// Same as Fimcp_basic::print
+static void print_style(FILE* out, const vector<Solution>& sols, PrintStyle style) {
+    SolutionWriter w(out);
+    int nr_i = sols[0].items.size();
+    int nr_t = sols[0].trans.size();
+    w.put_header(style, false, nr_i, nr_t);
+    vector<int>& ids = w.scratch_items();
+    vector<int>& tids = w.scratch_tids();
+    for (unsigned int s=0; s!=sols.size(); s++) {
+        const Solution& sol = sols[s];
+        ids.clear();
+        for (int i=0; i!=nr_i; i++) {
+            if (sol.items[i] == 1)
+                ids.push_back(i);
+        }
+        tids.clear();
+        if (style == PRINT_FULL || style == PRINT_BINFULL) {
+            for (int t=0; t!=nr_t; t++) {
+                if (sol.trans[t] == 1)
+                    tids.push_back(t);
+            }
+        }
+        w.put_solution(style, ids, false, sol.supp, 0, tids, nr_t);
+    }
+}
+
+static void print_writer(FILE* out, const vector<Solution>& sols, bool full) {
+    print_style(out, sols, (full ? PRINT_FULL : PRINT_FIMI));
+}
+
+static void print_binary(FILE* out, const vector<Solution>& sols, bool full) {
+    print_style(out, sols, (full ? PRINT_BINFULL : PRINT_BINARY));
+}
+
+static double timed(void (*f)(FILE*, const vector<Solution>&, bool),
+                    const char* file, const vector<Solution>& sols, bool full,
+                    long& bytes) {
+    FILE* out = fopen(file, "wb");
+    if (out == NULL) {
+        fprintf(stderr, "\tError: can not open %s !\n", file);
+        exit(1);
+    }
+    clock_t start = clock();
+    f(out, sols, full);
+    fflush(out);
+    clock_t stop = clock();
+    bytes = ftell(out);
+    fclose(out);
+    return (double)(stop-start)/CLOCKS_PER_SEC;
+}
+
+int main(int argc, char* argv[]) {
+    int nr_sols = 100000;
+    int nr_i = 200;
+    int nr_t = 2000;
+    const char* file = "bench_print.out";
+    if (argc > 1) nr_sols = atoi(argv[1]);
+    if (argc > 2) nr_i = atoi(argv[2]);
+    if (argc > 3) nr_t = atoi(argv[3]);
+    if (argc > 4) file = argv[4];
+    if (nr_sols <= 0 || nr_i <= 0 || nr_t <= 0) {
+        fprintf(stderr, "Usage: %s [solutions [items [transactions [outfile]]]]\n", argv[0]);
+        return 1;
+    }
+
+    // random solutions: ~5% of the items, ~20% of the transactions
+    srand(42);
+    vector<Solution> sols(nr_sols);
+    for (int s=0; s!=nr_sols; s++) {
+        sols[s].items.resize(nr_i);
+        for (int i=0; i!=nr_i; i++)
+            sols[s].items[i] = (rand()%20 == 0);
+        sols[s].trans.resize(nr_t);
+        sols[s].supp = 0;
+        for (int t=0; t!=nr_t; t++) {
+            sols[s].trans[t] = (rand()%5 == 0);
+            sols[s].supp += sols[s].trans[t];
+        }
+    }
+
+    fprintf(stdout, " %i solutions, %i items, %i transactions, writing to %s\n",
+            nr_sols, nr_i, nr_t, file);
+    for (int full=0; full!=2; full++) {
+        long b_old, b_new, b_bin;
+        double t_old = timed(print_fprintf, file, sols, full, b_old);
+        double t_new = timed(print_writer, file, sols, full, b_new);
+        double t_bin = timed(print_binary, file, sols, full, b_bin);
+        fprintf(stdout, " %s:\tfprintf %.3fs\twriter %.3fs\tspeedup %.1fx\n",
+                (full ? "full" : "normal"), t_old, t_new,
+                (t_new > 0 ? t_old/t_new : 0));
+        fprintf(stdout, " %s:\tbinary %.3fs\t%ld bytes instead of %ld\n",
+                (full ? "full" : "normal"), t_bin, b_bin, b_new);
+    }
+    if (argc <= 4)
+        remove(file);
+    return 0;
+}
@@ -0,0 +1,361 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * Benchmark of all models, with regression thresholds.
+ *
+ * Generates a few datasets with fimcp_gen and runs every fimcp_* binary
+ * on them at two thresholds (-output none). Per run it records the wall
+ * time (median of -repeat runs), the peak resident memory and the nodes,
+ * failures, propagations and solutions of the summary of the binary.
+ *
+ * The results are compared with the baseline file: a different number
+ * of solutions, more nodes, failures or propagations than the baseline
+ * (beyond -ctolerance) or a wall time or memory beyond -tolerance are
+ * regressions, and the exit status is 1. Without a baseline file, or
+ * with -update, the results become the baseline.
+ *
+ * With -verify every run is also checked by fimcp_verify against the
+ * reference enumerator; a difference counts as a failed run.
+ *
+ * Usage: fimcp_bench [-bindir .] [-dir bench.d] [-baseline bench.baseline]
+ *                    [-repeat 3] [-tolerance 0.25] [-ctolerance 0]
+ *                    [-models closed,cost,...] [-update] [-verify]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+using namespace std;
+
+static void error(const char* msg, const char* arg = "") {
+    fprintf(stderr, "\tError: %s%s !\n", msg, arg);
+    exit(1);
+}
+
+/// A generated dataset and its two thresholds
+struct Bench_data {
+    const char* name;
+    const char* gen; ///< the parameters of fimcp_gen
+    const char* freq[2];
+};
+
+/// Sparse (market basket like), dense and strongly correlated data, all
+/// with labels (for the discriminating models) and costs
+static const Bench_data datasets[] = {
+    {"sparse", "-D 5000 -N 200 -T 10 -I 4 -L 500 -pos 0.4 -contrast 0.8 -seed 1", {"0.02", "0.01"}},
+    {"dense", "-D 500 -N 40 -density 0.3 -L 100 -pos 0.5 -contrast 0.6 -seed 2", {"0.30", "0.20"}},
+    {"quest", "-D 2000 -N 100 -T 20 -I 6 -L 100 -corr 0.8 -pos 0.3 -contrast 0.9 -seed 3", {"0.10", "0.05"}},
+};
+
+/// A binary and its model specific options; @F is replaced by the threshold
+struct Bench_model {
+    const char* name;
+    const char* args;
+};
+
+static const Bench_model models[] = {
+    {"standard", ""},
+    {"closed", ""},
+    {"maximal", ""},
+    {"size", "-bound1 GQ 3"},
+    {"cost", "-attrfile @A -bound1 GQ 150"},
+    {"avgcost", "-attrfile @A -bound1 GQ 60"},
+    {"closed+cost", "-attrfile @A -bound1 GQ 150"},
+    {"deltaclosed", "-delta 0.90"},
+    {"discriminating", "-infreq @F"},
+    {"discriminating+deltaclosed", "-infreq @F -delta 0.90"},
+};
+
+/// The measurements of one run
+struct Bench_result {
+    double wall_ms;
+    long rss_kb;
+    unsigned long nodes, failures, propagations, solutions;
+};
+
+/// Split \a s on spaces, replacing @F by \a freq and @A by \a attr
+static void split(const string& s, const string& freq, const string& attr, vector<string>& args) {
+    size_t k = 0;
+    while (k < s.size()) {
+        size_t e = s.find(' ', k);
+        if (e == string::npos)
+            e = s.size();
+        string a = s.substr(k, e-k);
+        if (a == "@F")
+            a = freq;
+        else if (a == "@A")
+            a = attr;
+        if (!a.empty())
+            args.push_back(a);
+        k = e+1;
+    }
+}
+
+/// Run \a args, its output (stdout and stderr) in \a out; the exit status
+static int run(const vector<string>& args, string& out, double& wall_ms, long& rss_kb) {
+    int fd[2];
+    if (pipe(fd) != 0)
+        error("can not create a pipe");
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid < 0)
+        error("can not fork");
+    if (pid == 0) {
+        close(fd[0]);
+        dup2(fd[1], 1);
+        dup2(fd[1], 2);
+        close(fd[1]);
+        vector<char*> argv;
+        for (unsigned int k=0; k!=args.size(); k++)
+            argv.push_back(const_cast<char*>(args[k].c_str()));
+        argv.push_back(NULL);
+        execv(argv[0], &argv[0]);
+        fprintf(stderr, "\tError: can not run %s !\n", argv[0]);
+        _exit(127);
+    }
+    close(fd[1]);
+    out.clear();
+    char buf[4096];
+    ssize_t n;
+    while ((n = read(fd[0], buf, sizeof(buf))) > 0)
+        out.append(buf, n);
+    close(fd[0]);
+    int status;
+    struct rusage u;
+    if (wait4(pid, &status, 0, &u) != pid)
+        error("can not wait for ", args[0].c_str());
+    wall_ms = chrono::duration_cast<chrono::microseconds>(
+        chrono::steady_clock::now() - start).count() / 1000.0;
+    rss_kb = u.ru_maxrss; // KB on linux
+    return (WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status));
+}
+
+/// The value after "\tkey:" in the summary of a binary, 0 if not there
+static unsigned long summary(const string& out, const char* key) {
+    string k = string("\t") + key + ":";
+    size_t p = out.rfind(k);
+    if (p == string::npos)
+        return 0;
+    return strtoul(out.c_str() + p + k.size(), NULL, 10);
+}
+
+/// Key of a run in the baseline
+static string key(const string& data, const string& model, const string& freq) {
+    return data + " " + model + " " + freq;
+}
+
+static void read_baseline(const char* file, map<string,Bench_result>& base) {
+    FILE* f = fopen(file, "r");
+    if (f == NULL)
+        return;
+    char line[1024], data[256], model[256], freq[256];
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (line[0] == '#')
+            continue;
+        Bench_result r;
+        if (sscanf(line, "%255s %255s %255s %lf %ld %lu %lu %lu %lu", data, model, freq,
+                   &r.wall_ms, &r.rss_kb, &r.nodes, &r.failures, &r.propagations, &r.solutions) == 9)
+            base[key(data, model, freq)] = r;
+    }
+    fclose(f);
+}
+
+static void write_baseline(const char* file, const vector<string>& keys, map<string,Bench_result>& res) {
+    FILE* f = fopen(file, "w");
+    if (f == NULL)
+        error("can not open ", file);
+    fprintf(f, "# dataset model freq wall_ms rss_kb nodes failures propagations solutions\n");
+    for (unsigned int k=0; k!=keys.size(); k++) {
+        const Bench_result& r = res[keys[k]];
+        fprintf(f, "%s %.3f %ld %lu %lu %lu %lu\n", keys[k].c_str(), r.wall_ms, r.rss_kb,
+                r.nodes, r.failures, r.propagations, r.solutions);
+    }
+    fclose(f);
+}
+
+/// Whether \a now is worse than \a base by more than \a tol (and \a slack)
+static bool worse(double now, double base, double tol, double slack) {
+    return now > base*(1+tol) + slack;
+}
+
+int main(int argc, char* argv[]) {
+    string bindir = ".";
+    string dir = "bench.d";
+    const char* baseline = "bench.baseline";
+    int repeat = 3;
+    double tol = 0.25, ctol = 0;
+    string only;
+    bool update = false;
+    bool verify = false;
+    for (int k=1; k<argc; k++) {
+        string o = argv[k];
+        bool more = (k+1 < argc);
+        if (o == "-bindir" && more) bindir = argv[++k];
+        else if (o == "-dir" && more) dir = argv[++k];
+        else if (o == "-baseline" && more) baseline = argv[++k];
+        else if (o == "-repeat" && more) repeat = atoi(argv[++k]);
+        else if (o == "-tolerance" && more) tol = atof(argv[++k]);
+        else if (o == "-ctolerance" && more) ctol = atof(argv[++k]);
+        else if (o == "-models" && more) only = string(",") + argv[++k] + ",";
+        else if (o == "-update") update = true;
+        else if (o == "-verify") verify = true;
+        else {
+            fprintf(stderr, "Usage: %s [-bindir .] [-dir bench.d] [-baseline bench.baseline]\n"
+                    "\t[-repeat 3] [-tolerance 0.25] [-ctolerance 0] [-models closed,cost,...] [-update] [-verify]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+    if (repeat <= 0 || tol < 0 || ctol < 0)
+        error("-repeat must be positive, the tolerances not negative");
+    mkdir(dir.c_str(), 0755); // may exist
+
+    map<string,Bench_result> base, res;
+    read_baseline(baseline, base);
+    if (base.empty())
+        update = true;
+    vector<string> keys;
+    int regressions = 0, failed = 0;
+
+    for (unsigned int d=0; d!=sizeof(datasets)/sizeof(datasets[0]); d++) {
+        const Bench_data& data = datasets[d];
+        string file = dir + "/" + data.name + ".txt";
+        string attr = dir + "/" + data.name + ".attr";
+        vector<string> args(1, bindir + "/fimcp_gen");
+        split(data.gen, "", "", args);
+        args.push_back("-attrfile");
+        args.push_back(attr);
+        args.push_back(file);
+        string out;
+        double ms;
+        long kb;
+        if (run(args, out, ms, kb) != 0)
+            error("fimcp_gen failed: ", out.c_str());
+
+        for (unsigned int m=0; m!=sizeof(models)/sizeof(models[0]); m++) {
+            const Bench_model& model = models[m];
+            if (!only.empty() && only.find(string(",") + model.name + ",") == string::npos)
+                continue;
+            for (int f=0; f!=2; f++) {
+                string k = key(data.name, model.name, data.freq[f]);
+                args.assign(1, bindir + "/fimcp_" + model.name);
+                args.push_back("-datafile");
+                args.push_back(file);
+                args.push_back("-freq");
+                args.push_back(data.freq[f]);
+                args.push_back("-output");
+                args.push_back("none");
+                split(model.args, data.freq[f], attr, args);
+
+                Bench_result r;
+                vector<double> walls;
+                r.rss_kb = 0;
+                int status = 0;
+                for (int i=0; i!=repeat && status == 0; i++) {
+                    status = run(args, out, ms, kb);
+                    walls.push_back(ms);
+                    r.rss_kb = max(r.rss_kb, kb);
+                }
+                if (status != 0) {
+                    fprintf(stdout, " %-36s FAILED (exit %i)\n%s", k.c_str(), status, out.c_str());
+                    failed++;
+                    continue;
+                }
+                if (verify) {
+                    vector<string> check(1, bindir + "/fimcp_verify");
+                    check.push_back("-bindir");
+                    check.push_back(bindir);
+                    check.push_back(model.name);
+                    check.insert(check.end(), args.begin()+1, args.end());
+                    string diff;
+                    if (run(check, diff, ms, kb) != 0) {
+                        fprintf(stdout, " %-36s WRONG\n%s", k.c_str(), diff.c_str());
+                        failed++;
+                        continue;
+                    }
+                }
+                sort(walls.begin(), walls.end());
+                r.wall_ms = walls[walls.size()/2];
+                r.nodes = summary(out, "nodes");
+                r.failures = summary(out, "failures");
+                r.propagations = summary(out, "propagations");
+                r.solutions = summary(out, "solutions");
+                res[k] = r;
+                keys.push_back(k);
+
+                fprintf(stdout, " %-36s %10.3f ms %8ld KB %10lu nodes %10lu failures %12lu propagations %10lu solutions",
+                        k.c_str(), r.wall_ms, r.rss_kb, r.nodes, r.failures, r.propagations, r.solutions);
+                map<string,Bench_result>::const_iterator b = base.find(k);
+                if (b == base.end()) {
+                    fprintf(stdout, "  (new)\n");
+                    continue;
+                }
+                const Bench_result& o = b->second;
+                // small absolute slack: timer and page granularity
+                string why;
+                if (r.solutions != o.solutions) why += " solutions";
+                if (worse(r.nodes, o.nodes, ctol, 0)) why += " nodes";
+                if (worse(r.failures, o.failures, ctol, 0)) why += " failures";
+                if (worse(r.propagations, o.propagations, ctol, 0)) why += " propagations";
+                if (worse(r.wall_ms, o.wall_ms, tol, 5)) why += " time";
+                if (worse(r.rss_kb, o.rss_kb, tol, 1024)) why += " memory";
+                if (why.empty()) {
+                    fprintf(stdout, "  (%+.0f%% time)\n", (o.wall_ms > 0 ? 100*(r.wall_ms/o.wall_ms-1) : 0));
+                } else {
+                    fprintf(stdout, "  REGRESSION:%s (baseline %.3f ms %ld KB %lu nodes %lu failures %lu propagations %lu solutions)\n",
+                            why.c_str(), o.wall_ms, o.rss_kb, o.nodes, o.failures, o.propagations, o.solutions);
+                    regressions++;
+                }
+            }
+        }
+    }
+
+    fprintf(stdout, " bench: %lu runs, %i regressions, %i failed\n", keys.size(), regressions, failed);
+    if (update && failed == 0) {
+        write_baseline(baseline, keys, res);
+        fprintf(stdout, " bench: baseline written to %s\n", baseline);
+        return 0;
+    }
+    return (regressions != 0 || failed != 0);
+}
@@ -0,0 +1,240 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+/**
+ * Convert compact solution output back to the normal/full text output:
+ *  - binary solutions (-output binary/binaryfull), see common/binary_format.hh
+ *  - delta solutions (-output delta): every line is the nr of items
+ *    to pop from the previous itemset, the items to push and the support
+ *
+ * Usage: fimcp_decode [infile [txtfile]]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+#include "common/solution_writer.hh"
+
+static void error(const char* msg) {
+    fprintf(stderr, "\tError: %s !\n", msg);
+    exit(1);
+}
+
+/// Read a varint, returns false on a clean end of file
+static bool get_varint(FILE* in, unsigned int& v) {
+    v = 0;
+    int shift = 0;
+    int c;
+    while ((c = getc(in)) != EOF) {
+        if (shift > 28)
+            error("corrupt varint");
+        v |= (unsigned int)(c & 0x7f) << shift;
+        if ((c & 0x80) == 0)
+            return true;
+        shift += 7;
+    }
+    if (shift != 0)
+        error("unexpected end of file");
+    return false;
+}
+
+static unsigned int need_varint(FILE* in) {
+    unsigned int v;
+    if (!get_varint(in, v))
+        error("unexpected end of file");
+    return v;
+}
+
+/// Decode binary solutions from \a in
+static void decode_binary(FILE* in, SolutionWriter& w) {
+    // header
+    char magic[sizeof(BIN_MAGIC)];
+    if (fread(magic, 1, strlen(BIN_MAGIC), in) != strlen(BIN_MAGIC) ||
+        strncmp(magic, BIN_MAGIC, strlen(BIN_MAGIC)) != 0)
+        error("not a binary solution file");
+    int version = getc(in);
+    int flags = getc(in);
+    if (version != BIN_VERSION || flags == EOF)
+        error("unsupported binary solution file version");
+    need_varint(in); // nr_i
+    unsigned int nr_t = need_varint(in);
+
+    unsigned int n;
+    while (get_varint(in, n)) {
+        // items
+        unsigned int item = 0;
+        for (unsigned int k=0; k!=n; k++) {
+            item += need_varint(in) + (k == 0 ? 0 : 1);
+            w.put_uint(item);
+            w.put(' ');
+        }
+        // support
+        w.put('(');
+        unsigned int supp = need_varint(in);
+        if (flags & BIN_LABELS) {
+            unsigned int neg = need_varint(in);
+            w.put_uint(supp+neg);
+            w.put(":+", 2);
+            w.put_uint(supp);
+            w.put('-');
+            w.put_uint(neg);
+        } else {
+            w.put_uint(supp);
+        }
+        w.put(')');
+        // transactions
+        if (flags & BIN_TIDS) {
+            w.put(" <", 2);
+            int kind = getc(in);
+            if (kind == BIN_TIDS_RANGES) {
+                unsigned int r = need_varint(in);
+                unsigned int end = 0;
+                for (unsigned int k=0; k!=r; k++) {
+                    unsigned int start = end + need_varint(in);
+                    end = start + need_varint(in) + 1;
+                    for (unsigned int t=start; t!=end; t++) {
+                        w.put(' ');
+                        w.put_uint(t);
+                    }
+                }
+            } else if (kind == BIN_TIDS_BITMAP) {
+                for (unsigned int byte=0; byte != (nr_t+7)/8; byte++) {
+                    int c = getc(in);
+                    if (c == EOF)
+                        error("unexpected end of file");
+                    for (unsigned int b=0; b!=8; b++) {
+                        if (c & (1 << b)) {
+                            w.put(' ');
+                            w.put_uint(byte*8+b);
+                        }
+                    }
+                }
+            } else {
+                error("corrupt transaction set");
+            }
+            w.put(" >", 2);
+        }
+        w.put('\n');
+    }
+}
+
+/// Decode delta solutions from \a in
+static void decode_delta(FILE* in, SolutionWriter& w) {
+    vector<int> stack;
+    vector<int> sorted;
+    int c = getc(in);
+    while (c != EOF) {
+        if (c == '@' || c == '\n') {
+            // header or empty line: skip
+            while (c != '\n' && c != EOF)
+                c = getc(in);
+            c = getc(in);
+            continue;
+        }
+        // nr to pop, then items to push, up to the support
+        bool first = true;
+        while (c != '(') {
+            if (c == EOF || c == '\n')
+                error("corrupt delta line");
+            if (c == ' ') {
+                c = getc(in);
+                continue;
+            }
+            unsigned int v = 0;
+            while (c >= '0' && c <= '9') {
+                v = v*10 + (c-'0');
+                c = getc(in);
+            }
+            if (c != ' ' && c != '(')
+                error("corrupt delta line");
+            if (first) {
+                if (v > stack.size())
+                    error("corrupt delta line");
+                stack.resize(stack.size() - v);
+                first = false;
+            } else {
+                stack.push_back(v);
+            }
+        }
+        sorted = stack;
+        sort(sorted.begin(), sorted.end());
+        for (unsigned int k=0; k!=sorted.size(); k++) {
+            w.put_uint(sorted[k]);
+            w.put(' ');
+        }
+        // support, as is
+        while (c != '\n' && c != EOF) {
+            w.put((char)c);
+            c = getc(in);
+        }
+        w.put('\n');
+        if (c != EOF)
+            c = getc(in);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    FILE* in = stdin;
+    FILE* out = stdout;
+    if (argc > 1 && strcmp(argv[1], "-") != 0) {
+        in = fopen(argv[1], "rb");
+        if (in == NULL)
+            error("can not open input file");
+    }
+    if (argc > 2) {
+        out = fopen(argv[2], "w");
+        if (out == NULL)
+            error("can not open output file");
+    }
+
+    SolutionWriter w(out);
+    int c = getc(in);
+    ungetc(c, in);
+    if (c == BIN_MAGIC[0])
+        decode_binary(in, w);
+    else if (c == '@')
+        decode_delta(in, w);
+    else if (c != EOF)
+        error("unknown solution format, expected binary or delta output");
+    w.close();
+    if (in != stdin)
+        fclose(in);
+    if (out != stdout)
+        fclose(out);
+    return 0;
+}
@@ -0,0 +1,293 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * Synthetic transaction databases, in the style of the IBM Quest
+ * generator (Agrawal and Srikant, VLDB 1994).
+ *
+ * L potentially large itemsets ("patterns") of average size I are drawn
+ * from N items, every pattern shares a part of its items with the
+ * previous one (-corr). Every transaction has an average size of T and
+ * is filled with patterns, picked according to their weight and
+ * corrupted by dropping some of their items.
+ *
+ * Writes the annotated transaction format of Reader_Eliz: with -pos the
+ * last item of every transaction is its class label, 1 for a fraction
+ * -pos of them. Every pattern belongs to one class and with -contrast c
+ * a transaction takes a pattern of its own class with probability c,
+ * so that discriminating patterns exist. -attrfile also writes a cost
+ * for every item (for fimcp_cost and fimcp_avgcost).
+ *
+ * The output only depends on the parameters and -seed: the random
+ * numbers do not come from the standard library distributions, which
+ * differ between compilers.
+ *
+ * Usage: fimcp_gen [-D 10000] [-T 10] [-I 4] [-L 200] [-N 100]
+ *                  [-corr 0.5] [-density d] [-pos p] [-contrast c]
+ *                  [-attrfile file] [-costmax 100] [-seed 1] [outfile]
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+using namespace std;
+
+static void error(const char* msg, const char* arg = "") {
+    fprintf(stderr, "\tError: %s%s !\n", msg, arg);
+    exit(1);
+}
+
+/// 64 bit random numbers (splitmix64), the same on every platform
+class Random {
+    unsigned long long s;
+public:
+    Random(unsigned long long seed) : s(seed) {}
+    unsigned long long next(void) {
+        unsigned long long z = (s += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+    /// uniform in [0,1)
+    double uniform(void) {
+        return (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+    /// uniform in [0,n)
+    int below(int n) {
+        return (int)(uniform() * n);
+    }
+    /// exponential with mean \a m
+    double exponential(double m) {
+        return -m * log(1.0 - uniform());
+    }
+    /// normal with mean \a m and standard deviation \a sd (Box-Muller)
+    double normal(double m, double sd) {
+        double u = 1.0 - uniform();
+        double v = uniform();
+        return m + sd * sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+    }
+    /// poisson with mean \a m
+    int poisson(double m) {
+        if (m > 30) // normal approximation
+            return max(0, (int)floor(normal(m, sqrt(m)) + 0.5));
+        // Knuth
+        double l = exp(-m), p = 1.0;
+        int k = 0;
+        do {
+            k++;
+            p *= uniform();
+        } while (p > l);
+        return k-1;
+    }
+};
+
+/// A potentially large itemset
+struct Pattern {
+    vector<int> items;
+    /// cumulative weight, for picking
+    double weight;
+    /// fraction of its items dropped per use
+    double corruption;
+    /// class (with -pos)
+    bool pos;
+};
+
+/// Value of option \a o at argv[k]
+static double number(int argc, char* argv[], int k) {
+    if (k+1 >= argc)
+        error("missing value for ", argv[k]);
+    char* end;
+    double v = strtod(argv[k+1], &end);
+    if (*end != '\0')
+        error("not a number: ", argv[k+1]);
+    return v;
+}
+
+int main(int argc, char* argv[]) {
+    int D = 10000, N = 100, L = 200;
+    double T = 10, I = 4, corr = 0.5, density = 0, pos = -1, contrast = 0;
+    int costmax = 100;
+    unsigned long long seed = 1;
+    const char* attrfile = NULL;
+    const char* outfile = NULL;
+
+    for (int k=1; k<argc; k++) {
+        const char* o = argv[k];
+        if (strcmp(o,"-D") == 0) D = (int)number(argc, argv, k++);
+        else if (strcmp(o,"-T") == 0) T = number(argc, argv, k++);
+        else if (strcmp(o,"-I") == 0) I = number(argc, argv, k++);
+        else if (strcmp(o,"-L") == 0) L = (int)number(argc, argv, k++);
+        else if (strcmp(o,"-N") == 0) N = (int)number(argc, argv, k++);
+        else if (strcmp(o,"-corr") == 0) corr = number(argc, argv, k++);
+        else if (strcmp(o,"-density") == 0) density = number(argc, argv, k++);
+        else if (strcmp(o,"-pos") == 0) pos = number(argc, argv, k++);
+        else if (strcmp(o,"-contrast") == 0) contrast = number(argc, argv, k++);
+        else if (strcmp(o,"-costmax") == 0) costmax = (int)number(argc, argv, k++);
+        else if (strcmp(o,"-seed") == 0) seed = (unsigned long long)number(argc, argv, k++);
+        else if (strcmp(o,"-attrfile") == 0) {
+            if (k+1 >= argc)
+                error("missing value for ", o);
+            attrfile = argv[++k];
+        } else if (o[0] == '-' && o[1] != '\0') {
+            fprintf(stderr, "Usage: %s [-D 10000] [-T 10] [-I 4] [-L 200] [-N 100] [-corr 0.5]\n"
+                    "\t[-density d] [-pos p] [-contrast c] [-attrfile file] [-costmax 100] [-seed 1] [outfile]\n"
+                    "  -D transactions, -T average transaction size, -I average pattern size,\n"
+                    "  -L nr of patterns, -N nr of items, -corr correlation between patterns,\n"
+                    "  -density fraction of ones (sets -T to density*N), -pos fraction of positive\n"
+                    "  transactions (adds class labels), -contrast probability that a transaction\n"
+                    "  takes a pattern of its own class, -attrfile also write item costs in\n"
+                    "  1..costmax\n", argv[0]);
+            return 1;
+        } else {
+            outfile = o;
+        }
+    }
+    if (density > 0)
+        T = density * N;
+    if (D <= 0 || N <= 0 || L <= 0 || T <= 0 || I <= 0 || costmax <= 0)
+        error("-D, -N, -L, -T, -I and -costmax must be positive");
+    if (corr < 0 || corr > 1 || contrast < 0 || contrast > 1 || pos > 1)
+        error("-corr, -contrast and -pos must be in [0,1]");
+
+    FILE* out = stdout;
+    if (outfile != NULL && strcmp(outfile, "-") != 0) {
+        out = fopen(outfile, "w");
+        if (out == NULL)
+            error("can not open ", outfile);
+    }
+
+    Random rnd(seed);
+
+    // patterns: part of the items from the previous pattern, the rest random
+    vector<Pattern> patterns(L);
+    double total = 0;
+    vector<char> in(N);
+    for (int p=0; p!=L; p++) {
+        Pattern& pat = patterns[p];
+        int size = min(N, max(1, rnd.poisson(I)));
+        fill(in.begin(), in.end(), 0);
+        if (p != 0) {
+            const vector<int>& prev = patterns[p-1].items;
+            int shared = min((int)prev.size(), min(size, (int)(rnd.exponential(corr) * size)));
+            for (int k=0; k!=shared; k++) {
+                int i = prev[rnd.below(prev.size())];
+                if (!in[i]) {
+                    in[i] = 1;
+                    pat.items.push_back(i);
+                }
+            }
+        }
+        while ((int)pat.items.size() < size) {
+            int i = rnd.below(N);
+            if (!in[i]) {
+                in[i] = 1;
+                pat.items.push_back(i);
+            }
+        }
+        total += rnd.exponential(1.0);
+        pat.weight = total;
+        pat.corruption = min(1.0, max(0.0, rnd.normal(0.5, sqrt(0.1))));
+        pat.pos = (rnd.uniform() < 0.5);
+    }
+    for (int p=0; p!=L; p++)
+        patterns[p].weight /= total;
+
+    // transactions
+    vector<int> trans;
+    vector<int> left; // the pattern that did not fit, for the next transaction
+    for (int t=0; t!=D; t++) {
+        bool is_pos = (pos >= 0 && rnd.uniform() < pos);
+        int size = min(N, max(1, rnd.poisson(T)));
+        fill(in.begin(), in.end(), 0);
+        trans.clear();
+        int tries = 0;
+        while ((int)trans.size() < size && tries++ < 10*size + 100) {
+            const Pattern* pat;
+            if (!left.empty()) {
+                pat = &patterns[left.back()];
+                left.pop_back();
+            } else {
+                // pick by weight, of the own class with probability contrast
+                bool own = (pos >= 0 && rnd.uniform() < contrast);
+                double w = rnd.uniform();
+                int p = lower_bound(patterns.begin(), patterns.end(), w,
+                                    [](const Pattern& a, double v) { return a.weight < v; })
+                        - patterns.begin();
+                p = min(p, L-1);
+                for (int k=0; own && patterns[p].pos != is_pos && k!=L; k++)
+                    p = (p+1) % L;
+                pat = &patterns[p];
+            }
+            // corrupt: drop items while uniform < corruption
+            vector<int> items = pat->items;
+            while (!items.empty() && rnd.uniform() < pat->corruption)
+                items.erase(items.begin() + rnd.below(items.size()));
+            if ((int)(trans.size() + items.size()) > size && !trans.empty()) {
+                // does not fit: in this one half of the time, else the next one
+                if (rnd.uniform() < 0.5) {
+                    left.push_back(pat - &patterns[0]);
+                    break;
+                }
+            }
+            for (unsigned int k=0; k!=items.size(); k++) {
+                if (!in[items[k]]) {
+                    in[items[k]] = 1;
+                    trans.push_back(items[k]);
+                }
+            }
+        }
+        if (trans.empty()) // every transaction has an item
+            trans.push_back(rnd.below(N));
+        sort(trans.begin(), trans.end());
+        for (unsigned int k=0; k!=trans.size(); k++)
+            fprintf(out, "%i ", trans[k]);
+        if (pos >= 0)
+            fprintf(out, "%i", (int)is_pos);
+        fprintf(out, "\n");
+    }
+    if (out != stdout)
+        fclose(out);
+
+    if (attrfile != NULL) {
+        FILE* f = fopen(attrfile, "w");
+        if (f == NULL)
+            error("can not open ", attrfile);
+        for (int i=0; i!=N; i++)
+            fprintf(f, "%i%s", 1 + rnd.below(costmax), (i+1 == N ? "\n" : " "));
+        fclose(f);
+    }
+    return 0;
+}
@@ -0,0 +1,467 @@
+/*
+ *  Main authors:
+ *      Tias Guns <tias.guns@cs.kuleuven.be>
+ *
+ *  Copyright:
+ *      Tias Guns, 2011
+ *
+ *  Revision information:
+ *      $Id$
+ *
+ *  This file is part of Fim_cp, Frequent Itemset Mining using
+ *  Constraint Programming, and uses Gecode.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+/**
+ * Cross-check of a model against a reference enumerator.
+ *
+ * Runs fimcp_<model> with the given options and writes its solutions
+ * to a temporary file, then enumerates the same solutions without
+ * Gecode: Apriori (level-wise, candidates of which every subset is
+ * frequent) lists every frequent itemset and every one of them is
+ * checked against the constraints of the model, in the form that the
+ * model posts them (eg. item i is in a closed itemset iff its column
+ * covers all transactions of the itemset). Both result sets are
+ * canonicalized (sorted items, supports) and compared; the differences
+ * are printed and the exit status is 1.
+ *
+ * The reference is slow and simple on purpose: it shares no code with
+ * the models or the native engines, other than reading the dataset.
+ *
+ * Usage: fimcp_verify [-bindir .] [-show 10] <model> <options of fimcp_<model>>
+ *   eg.  fimcp_verify closed -datafile example.txt -freq 0.10
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+using namespace std;
+
+#include "common/dataset.hh"
+#include "common/reader_ssv.cpp"
+
+#define PRECISION 1000 // as the delta-closed models
+
+static void error(const char* msg, const char* arg = "") {
+    fprintf(stderr, "\tError: %s%s !\n", msg, arg);
+    exit(1);
+}
+
+/// The options of the models that the reference needs, with the defaults of the models
+struct Verify_options {
+    string datafile, attrfile;
+    double freq, infreq, delta;
+    string bound_op;
+    int bound_val;
+    Verify_options(void)
+        : datafile("../data/example.txt"), attrfile("../data/example.attr"),
+          freq(0.10), infreq(0.10), delta(0.80), bound_op("GQ"), bound_val(0) {}
+};
+
+/// Which constraints the model posts
+struct Verify_model {
+    const char* name;
+    bool labels, closed, deltaclosed, maximal, size, cost, avgcost;
+};
+
+static const Verify_model verify_models[] = {
+    // name                        labels closed delta  maximal size   cost   avgcost
+    {"standard",                   false, false, false, false, false, false, false},
+    {"closed",                     false, true,  false, false, false, false, false},
+    {"maximal",                    false, false, false, true,  false, false, false},
+    {"size",                       false, false, false, false, true,  false, false},
+    {"cost",                       false, false, false, false, false, true,  false},
+    {"avgcost",                    false, false, false, false, false, false, true},
+    {"closed+cost",                false, true,  false, false, false, true,  false},
+    {"deltaclosed",                false, false, true,  false, false, false, false},
+    {"discriminating",             true,  false, false, false, false, false, false},
+    {"discriminating+deltaclosed", true,  false, true,  false, false, false, false},
+};
+
+/// Transaction set as bitmap
+typedef vector<unsigned long long> Tids;
+
+static int count(const Tids& a) {
+    int c = 0;
+    for (unsigned int w=0; w!=a.size(); w++)
+        c += __builtin_popcountll(a[w]);
+    return c;
+}
+
+static int count_and(const Tids& a, const Tids& b) {
+    int c = 0;
+    for (unsigned int w=0; w!=a.size(); w++)
+        c += __builtin_popcountll(a[w] & b[w]);
+    return c;
+}
+
+static bool compare(long v, const string& op, long b) {
+    if (op == "EQ") return v == b;
+    if (op == "NQ") return v != b;
+    if (op == "LQ") return v <= b;
+    if (op == "LE") return v < b;
+    if (op == "GQ") return v >= b;
+    if (op == "GR") return v > b;
+    error("unknown relation ", op.c_str());
+    return false;
+}
+
+/// An itemset of the current Apriori level and its transactions
+struct Candidate {
+    vector<int> items;
+    Tids tids;
+};
+
+/**
+ * The reference enumerator: every frequent itemset (frequent on the
+ * positive transactions for the discriminating models) that satisfies
+ * the constraints of the model, canonicalized as in write_canonical.
+ */
+class Reference {
+    const Dataset& data;
+    const Verify_model& model;
+    const Verify_options& opt;
+    int words;
+    vector<Tids> cover; ///< per item
+    Tids pos, neg, all; ///< per class, with labels
+    int freq, infreq, hdelta;
+    vector<int> cost;
+public:
+    Reference(const Dataset& d, const Verify_model& m, const Verify_options& o)
+        : data(d), model(m), opt(o), words((d.nr_t+63)/64) {
+        cover.assign(data.nr_i, Tids(words, 0));
+        all.assign(words, 0);
+        pos.assign(words, 0);
+        for (int t=0; t!=data.nr_t; t++) {
+            all[t/64] |= 1ULL << (t%64);
+            if (model.labels && data.classes[t])
+                pos[t/64] |= 1ULL << (t%64);
+            for (int i=0; i!=data.nr_i; i++)
+                if (data.tdb[t][i])
+                    cover[i][t/64] |= 1ULL << (t%64);
+        }
+        neg.assign(words, 0);
+        for (int w=0; w!=words; w++)
+            neg[w] = all[w] & ~pos[w];
+        // the thresholds as Options_fimcp::getFreq and getInfreq
+        int total = (model.labels ? count(pos) : data.nr_t);
+        freq = (opt.freq < 1 ? (int)floor(opt.freq*total + 0.5) : (int)opt.freq);
+        int negs = data.nr_t - count(pos);
+        infreq = (opt.infreq < 1 ? (int)(opt.infreq*negs) : (int)opt.infreq);
+        hdelta = (int)(opt.delta*PRECISION);
+        if (model.cost || model.avgcost) {
+            Reader_SSV<int> attr;
+            attr.read(opt.attrfile);
+            if (attr.data.size() == 0 || (int)attr.data[0].size() < data.nr_i)
+                error("not a cost for every item in ", opt.attrfile.c_str());
+            cost = attr.data[0];
+        }
+    }
+
+    /// The support that the frequency constraint counts
+    int support(const Tids& t) const {
+        return (model.labels ? count_and(t, pos) : count(t));
+    }
+
+    /// Whether \a c satisfies the constraints of the model
+    bool accept(const Candidate& c) const {
+        const Tids& t = c.tids;
+        vector<char> in(data.nr_i, 0);
+        for (unsigned int k=0; k!=c.items.size(); k++)
+            in[c.items[k]] = 1;
+        int supp = support(t);
+        if (!model.maximal && !c.items.empty() && supp < freq)
+            return false;
+        if (model.labels && count_and(t, neg) > infreq)
+            return false;
+        long size = c.items.size(), sum = 0, avg = 0;
+        for (unsigned int k=0; k!=c.items.size(); k++) {
+            if (model.cost || model.avgcost) {
+                sum += cost[c.items[k]];
+                avg += cost[c.items[k]] - opt.bound_val;
+            }
+        }
+        if (model.size && !compare(size, opt.bound_op, opt.bound_val))
+            return false;
+        if (model.cost && !compare(sum, opt.bound_op, opt.bound_val))
+            return false;
+        if (model.avgcost && !compare(avg, opt.bound_op, 0))
+            return false;
+        // the reified constraints: item i is in iff ...
+        const Tids& base = (model.labels ? pos : all);
+        for (int i=0; i!=data.nr_i; i++) {
+            bool holds = true;
+            if (model.closed) {
+                // ... it covers every transaction of the itemset
+                holds = (count_and(t, cover[i]) == count(t));
+            } else if (model.deltaclosed) {
+                // ... sum over the (positive) transactions of (1-d_ti)*1000 - delta*1000 <= 0
+                Tids tb(words);
+                for (int w=0; w!=words; w++)
+                    tb[w] = t[w] & base[w];
+                long covered = count(tb), missing = covered - count_and(tb, cover[i]);
+                holds = (missing*PRECISION - (long)hdelta*covered <= 0);
+            } else if (model.maximal) {
+                // ... it is frequent in the transactions of the itemset
+                holds = (support_and(t, i) >= freq);
+            } else {
+                continue;
+            }
+            if (holds != (bool)in[i])
+                return false;
+        }
+        return true;
+    }
+
+    int support_and(const Tids& t, int i) const {
+        Tids ti(words);
+        for (int w=0; w!=words; w++)
+            ti[w] = t[w] & cover[i][w];
+        return support(ti);
+    }
+
+    /// Canonical line of \a c: its sorted items and its support(s)
+    string canonical(const Candidate& c) const {
+        string s;
+        char buf[64];
+        for (unsigned int k=0; k!=c.items.size(); k++) {
+            snprintf(buf, sizeof(buf), "%i ", c.items[k]);
+            s += buf;
+        }
+        if (model.labels) {
+            int p = count_and(c.tids, pos), n = count_and(c.tids, neg);
+            snprintf(buf, sizeof(buf), "(%i:+%i-%i)", p+n, p, n);
+        } else {
+            snprintf(buf, sizeof(buf), "(%i)", count(c.tids));
+        }
+        return s + buf;
+    }
+
+    /// Apriori: level k+1 joins the itemsets of level k with the same
+    /// first k-1 items, of which every k-subset is frequent
+    void run(set<string>& sols) {
+        vector<Candidate> level(1);
+        level[0].tids = all;
+        if (accept(level[0]))
+            sols.insert(canonical(level[0]));
+        // level 1
+        vector<Candidate> next;
+        for (int i=0; i!=data.nr_i; i++) {
+            Candidate c;
+            c.items.push_back(i);
+            c.tids = cover[i];
+            if (support(c.tids) >= freq)
+                next.push_back(c);
+        }
+        while (!next.empty()) {
+            level.swap(next);
+            next.clear();
+            set< vector<int> > frequent;
+            for (unsigned int k=0; k!=level.size(); k++) {
+                if (accept(level[k]))
+                    sols.insert(canonical(level[k]));
+                frequent.insert(level[k].items);
+            }
+            for (unsigned int a=0; a!=level.size(); a++) {
+                for (unsigned int b=a+1; b!=level.size(); b++) {
+                    const vector<int>& ia = level[a].items;
+                    const vector<int>& ib = level[b].items;
+                    if (!equal(ia.begin(), ia.end()-1, ib.begin()))
+                        break; // sorted: no more with the same prefix
+                    Candidate c;
+                    c.items = ia;
+                    c.items.push_back(ib.back());
+                    // prune: every subset of size k is frequent
+                    bool ok = true;
+                    for (unsigned int d=0; ok && d+2<c.items.size(); d++) {
+                        vector<int> sub = c.items;
+                        sub.erase(sub.begin()+d);
+                        ok = (frequent.count(sub) != 0);
+                    }
+                    if (!ok)
+                        continue;
+                    c.tids.resize(words);
+                    for (int w=0; w!=words; w++)
+                        c.tids[w] = level[a].tids[w] & level[b].tids[w];
+                    if (support(c.tids) >= freq)
+                        next.push_back(c);
+                }
+            }
+        }
+    }
+};
+
+/// The solutions in FIMI format written by the model, canonicalized
+static void read_solutions(const char* file, set<string>& sols, unsigned long& lines) {
+    FILE* f = fopen(file, "r");
+    if (f == NULL)
+        error("no solutions written to ", file);
+    char line[1<<16];
+    lines = 0;
+    while (fgets(line, sizeof(line), f) != NULL) {
+        char* paren = strchr(line, '(');
+        if (paren == NULL)
+            continue;
+        lines++;
+        vector<int> items;
+        char* p = line;
+        while (p < paren) {
+            char* end;
+            long v = strtol(p, &end, 10);
+            if (end == p)
+                break;
+            items.push_back(v);
+            p = end;
+        }
+        sort(items.begin(), items.end());
+        string s;
+        char buf[64];
+        for (unsigned int k=0; k!=items.size(); k++) {
+            snprintf(buf, sizeof(buf), "%i ", items[k]);
+            s += buf;
+        }
+        char* end = strchr(paren, ')');
+        if (end == NULL)
+            error("bad solution line in ", file);
+        s += string(paren, end+1);
+        sols.insert(s);
+    }
+    fclose(f);
+}
+
+/// Print at most \a show lines of \a a that are not in \a b
+static unsigned long difference(const set<string>& a, const set<string>& b,
+                                const char* what, unsigned int show) {
+    unsigned long n = 0;
+    for (set<string>::const_iterator s=a.begin(); s!=a.end(); s++) {
+        if (b.count(*s) != 0)
+            continue;
+        if (n++ < show)
+            fprintf(stdout, "  %s: %s\n", what, s->c_str());
+    }
+    return n;
+}
+
+int main(int argc, char* argv[]) {
+    string bindir = ".";
+    unsigned int show = 10;
+    int k = 1;
+    for (; k+1<argc && argv[k][0] == '-'; k+=2) {
+        if (strcmp(argv[k], "-bindir") == 0) bindir = argv[k+1];
+        else if (strcmp(argv[k], "-show") == 0) show = atoi(argv[k+1]);
+        else break;
+    }
+    if (k >= argc || argv[k][0] == '-') {
+        fprintf(stderr, "Usage: %s [-bindir .] [-show 10] <model> <options of fimcp_<model>>\n", argv[0]);
+        return 1;
+    }
+    const Verify_model* model = NULL;
+    for (unsigned int m=0; m!=sizeof(verify_models)/sizeof(verify_models[0]); m++) {
+        if (strcmp(argv[k], verify_models[m].name) == 0)
+            model = &verify_models[m];
+    }
+    if (model == NULL)
+        error("no reference for model ", argv[k]);
+
+    // the options of the binary, without its output options
+    char solfile[] = "/tmp/fimcp_verify.XXXXXX";
+    int fd = mkstemp(solfile);
+    if (fd < 0)
+        error("can not create a temporary file");
+    close(fd);
+    vector<string> args(1, bindir + "/fimcp_" + model->name);
+    Verify_options opt;
+    for (k++; k<argc; k++) {
+        string o = argv[k];
+        bool more = (k+1 < argc);
+        if ((o == "-output" || o == "-solfile") && more) {
+            k++;
+            continue;
+        }
+        args.push_back(o);
+        if (!more)
+            continue;
+        if (o == "-datafile") opt.datafile = argv[k+1];
+        else if (o == "-attrfile") opt.attrfile = argv[k+1];
+        else if (o == "-freq") opt.freq = atof(argv[k+1]);
+        else if (o == "-infreq") opt.infreq = atof(argv[k+1]);
+        else if (o == "-delta") opt.delta = atof(argv[k+1]);
+        else if (o == "-bound1" && k+2 < argc) {
+            opt.bound_op = argv[k+1];
+            opt.bound_val = atoi(argv[k+2]);
+        }
+    }
+    args.push_back("-output");
+    args.push_back("normal");
+    args.push_back("-solfile");
+    args.push_back(solfile);
+
+    // the model, its summary is not needed
+    pid_t pid = fork();
+    if (pid < 0)
+        error("can not fork");
+    if (pid == 0) {
+        int null = open("/dev/null", O_WRONLY);
+        dup2(null, 1);
+        vector<char*> av;
+        for (unsigned int a=0; a!=args.size(); a++)
+            av.push_back(const_cast<char*>(args[a].c_str()));
+        av.push_back(NULL);
+        execv(av[0], &av[0]);
+        fprintf(stderr, "\tError: can not run %s !\n", av[0]);
+        _exit(127);
+    }
+    int status;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        remove(solfile);
+        error("the model failed: ", args[0].c_str());
+    }
+    set<string> found;
+    unsigned long lines;
+    read_solutions(solfile, found, lines);
+    remove(solfile);
+
+    // the reference
+    Dataset data(opt.datafile.c_str());
+    if (model->labels && data.classes.size() == 0)
+        error("no class labels in ", opt.datafile.c_str());
+    set<string> expected;
+    Reference(data, *model, opt).run(expected);
+
+    unsigned long missing = difference(expected, found, "missing", show);
+    unsigned long extra = difference(found, expected, "extra", show);
+    unsigned long dups = lines - found.size();
+    fprintf(stdout, " verify %s: %lu solutions, reference %lu, %lu missing, %lu extra, %lu duplicates: %s\n",
+            model->name, lines, (unsigned long)expected.size(), missing, extra, dups,
+            (missing == 0 && extra == 0 && dups == 0 ? "ok" : "DIFFERENT"));
+    return (missing != 0 || extra != 0 || dups != 0);
+}